@@ -1,9 +1,11 @@
+#include <Vnetworking/Platform.h>
+
+#ifdef NE_PLATFORM_WINDOWS
+
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
 #include <WinSock2.h>
 
-#include <Vnetworking/Platform.h>
-
 #pragma comment (lib, "WS2_32.lib")
 
 static bool Initialize(void);
@@ -36,4 +38,6 @@ static bool Initialize() {
 
 static void Uninitialize() { 
 	WSACleanup();
-}
\ No newline at end of file
+}
+
+#endif
\ No newline at end of file
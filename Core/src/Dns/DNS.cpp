@@ -1,12 +1,9 @@
 #include <Vnetworking/Dns/DNS.h>
 #include <Vnetworking/Sockets/SocketException.h>
+#include "../Sockets/Native.h"
 
-#define WIN32_LEAN_AND_MEAN
-#include <Windows.h>
-#include <WinSock2.h>
-#include <WS2tcpip.h>
-#include <iphlpapi.h>
-
+#include <array>
+#include <cstring>
 #include <string>
 #include <optional>
 #include <algorithm>
@@ -15,6 +12,7 @@
 using namespace Vnetworking;
 using namespace Vnetworking::Dns;
 using namespace Vnetworking::Sockets;
+using namespace Vnetworking::Sockets::Private;
 
 static inline bool IsNotIpAddress(const std::string& str) noexcept {
 	
@@ -34,7 +32,7 @@ DnsLookupResult DNS::Resolve(const std::string& hostname) {
 	std::vector<IpAddress> addresses = { };
 
 	struct addrinfo* result = NULL, * ptr = NULL, hints;
-	ZeroMemory(&hints, sizeof(hints));
+	std::memset(&hints, 0, sizeof(hints));
 	hints.ai_family = AF_UNSPEC;
 	hints.ai_flags = AI_CANONNAME;
 
@@ -45,7 +43,7 @@ DnsLookupResult DNS::Resolve(const std::string& hostname) {
 		&result
 	);
 
-	if (res) throw SocketException(WSAGetLastError());
+	if (res) throw CreateAddrinfoException(res);
 
 	for (ptr = result; ptr != NULL; ptr = ptr->ai_next) {
 
@@ -59,7 +57,7 @@ DnsLookupResult DNS::Resolve(const std::string& hostname) {
 
 		if (ptr->ai_family == AF_INET) {
 			struct sockaddr_in* sockaddr = reinterpret_cast<struct sockaddr_in*>(ptr->ai_addr);
-			const std::uint32_t addr = sockaddr->sin_addr.S_un.S_addr;
+			const std::uint32_t addr = sockaddr->sin_addr.s_addr;
 			addresses.push_back({ (addr & 0xFF), ((addr >> 8) & 0xFF), ((addr >> 16) & 0xFF), ((addr >> 24) & 0xFF) });
 		}
 		else {
@@ -67,15 +65,7 @@ DnsLookupResult DNS::Resolve(const std::string& hostname) {
 			struct sockaddr_in6* sockaddr = reinterpret_cast<struct sockaddr_in6*>(ptr->ai_addr);
 
 			std::array<std::uint8_t, 16> bytes;
-			std::size_t bytesPos = 0;
-
-			for (int i = 0; i < 8; ++i) {
-				const std::uint16_t* word = sockaddr->sin6_addr.u.Word;
-				const std::uint8_t l = ((word[i] >> 8) & 0xFF);
-				const std::uint8_t h = (word[i] & 0xFF);
-				bytes[bytesPos++] = h;
-				bytes[bytesPos++] = l;
-			}
+			std::memcpy(bytes.data(), sockaddr->sin6_addr.s6_addr, bytes.size());
 
 			addresses.push_back({ bytes });
 
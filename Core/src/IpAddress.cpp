@@ -6,12 +6,20 @@
 #include <regex>
 #include <exception>
 #include <algorithm>
+#include <cstring>
 
+#include <Vnetworking/Platform.h>
+
+#ifdef NE_PLATFORM_WINDOWS
 #define WIN32_LEAN_AND_MEAN
 #define _WINSOCK_DEPRECATED_NO_WARNINGS
 #include <Windows.h>
 #include <WinSock2.h>
 #include <WS2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#endif
 
 using namespace Vnetworking;
 
@@ -24,7 +32,7 @@ IpAddress::IpAddress(const std::uint8_t aa, const std::uint8_t bb, const std::ui
 	
 	this->m_isVersion6 = false;
 	
-	memset(this->m_bytes.data(), 0, this->m_bytes.size());
+	std::memset(this->m_bytes.data(), 0, this->m_bytes.size());
 	this->m_bytes[0] = aa;
 	this->m_bytes[1] = bb;
 	this->m_bytes[2] = cc;
@@ -37,7 +45,7 @@ IpAddress::IpAddress(const std::array<std::uint8_t, 4>& address)
 
 IpAddress::IpAddress(const std::array<std::uint8_t, 16>& address) {
 	this->m_isVersion6 = true;
-	memcpy_s(this->m_bytes.data(), this->m_bytes.size(), address.data(), address.size());
+	std::memcpy(this->m_bytes.data(), address.data(), this->m_bytes.size());
 }
 
 IpAddress::IpAddress(const IpAddress& address) {
@@ -52,7 +60,7 @@ IpAddress::~IpAddress() { }
 
 IpAddress& IpAddress::operator= (const IpAddress& address) {
 	this->m_isVersion6 = address.m_isVersion6;
-	memcpy_s(this->m_bytes.data(), this->m_bytes.size(), address.m_bytes.data(), address.m_bytes.size());
+	std::memcpy(this->m_bytes.data(), address.m_bytes.data(), this->m_bytes.size());
 	return static_cast<IpAddress&>(*this);
 }
 
@@ -157,6 +165,15 @@ bool IpAddress::IsPrivateAddress() const {
 	);
 }
 
+// 224.0.0.0/4 for IPv4, ff00::/8 for IPv6.
+bool IpAddress::IsMulticastAddress() const {
+
+	if (this->m_isVersion6)
+		return (this->m_bytes[0] == 0xFF);
+
+	return ((this->m_bytes[0] & 0xF0) == 0xE0);
+}
+
 IpAddress IpAddress::Parse(const std::string& ipAddress) {
 
 	const bool isVersion4 = std::regex_match(ipAddress, s_ipv4Regex);
@@ -169,6 +186,8 @@ IpAddress IpAddress::Parse(const std::string& ipAddress) {
 	if (isVersion4) {
 
 		struct sockaddr_in sockaddr;
+
+#ifdef NE_PLATFORM_WINDOWS
 		std::int32_t sockaddrLen = sizeof(sockaddr);
 
 		int res = WSAStringToAddressA(
@@ -181,8 +200,12 @@ IpAddress IpAddress::Parse(const std::string& ipAddress) {
 
 		if (res == SOCKET_ERROR)
 			throw std::invalid_argument("The provided address is not a valid IPv4 address.");
+#else
+		if (inet_pton(AF_INET, ipAddress.c_str(), &sockaddr.sin_addr) != 1)
+			throw std::invalid_argument("The provided address is not a valid IPv4 address.");
+#endif
 
-		const std::uint32_t addr = sockaddr.sin_addr.S_un.S_addr;
+		const std::uint32_t addr = sockaddr.sin_addr.s_addr;
 
 		return { (addr & 0xFF), ((addr >> 8) & 0xFF), ((addr >> 16) & 0xFF), ((addr >> 24) & 0xFF) };
 	}
@@ -190,6 +213,8 @@ IpAddress IpAddress::Parse(const std::string& ipAddress) {
 	// parse IPv6 address:
 
 	struct sockaddr_in6 sockaddr;
+
+#ifdef NE_PLATFORM_WINDOWS
 	std::int32_t sockaddrLen = sizeof(sockaddr);
 
 	int res = WSAStringToAddressA(
@@ -202,17 +227,15 @@ IpAddress IpAddress::Parse(const std::string& ipAddress) {
 
 	if (res == SOCKET_ERROR)
 		throw std::invalid_argument("The provided address is not a valid IPv6 address.");
+#else
+	// inet_pton does not understand scope ids, so strip the "%zone" suffix before parsing.
+	const std::string address = ipAddress.substr(0, ipAddress.find('%'));
+	if (inet_pton(AF_INET6, address.c_str(), &sockaddr.sin6_addr) != 1)
+		throw std::invalid_argument("The provided address is not a valid IPv6 address.");
+#endif
 
 	std::array<std::uint8_t, 16> bytes = { 0 };
-	std::int32_t bytesPos = 0;
-
-	for (int i = 0; i < 8; ++i) {
-		const std::uint16_t* word = sockaddr.sin6_addr.u.Word;
-		const std::uint8_t l = ((word[i] >> 8) & 0xFF);
-		const std::uint8_t h = (word[i] & 0xFF);
-		bytes[bytesPos++] = h;
-		bytes[bytesPos++] = l;
-	}
+	std::memcpy(bytes.data(), sockaddr.sin6_addr.s6_addr, bytes.size());
 
 	return { bytes };
 }
\ No newline at end of file
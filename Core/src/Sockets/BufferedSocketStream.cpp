@@ -0,0 +1,252 @@
+#include <Vnetworking/Sockets/BufferedSocketStream.h>
+#include <Vnetworking/Sockets/SocketException.h>
+#include "Native.h"
+
+#ifndef NE_PLATFORM_WINDOWS
+#include <sys/mman.h>
+#endif
+
+#include <cstring>
+#include <bit>
+#include <limits>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using namespace Vnetworking::Sockets;
+using namespace Vnetworking::Sockets::Private;
+
+constexpr std::string_view ERR_CAPACITY_ZERO = "'capacity' is zero.";
+constexpr std::string_view ERR_EMPTY_DELIMITER = "'delimiter' is empty.";
+constexpr std::string_view ERR_SIZE_GREATER_THAN_CAPACITY = "'size' is greater than the buffer capacity.";
+constexpr std::string_view ERR_SIZE_GREATER_THAN_BUFFERED = "'size' is greater than the number of buffered bytes.";
+constexpr std::string_view ERR_BUFFER_FULL = "The buffer is full.";
+constexpr std::string_view ERR_END_OF_STREAM = "The end of the stream was reached.";
+
+constexpr std::size_t DEFAULT_CAPACITY = 65536;
+
+#ifndef NE_PLATFORM_WINDOWS
+
+// maps the same memory twice, back to back, so that the ring's data is contiguous even when it wraps around.
+// returns nullptr if the mapping could not be created.
+static std::uint8_t* CreateMirroredBuffer(const std::size_t capacity) noexcept {
+
+	const int fd = memfd_create("vnetworking-ring", MFD_CLOEXEC);
+	if (fd == -1) return nullptr;
+
+	if (ftruncate(fd, static_cast<off_t>(capacity)) == -1) {
+		close(fd);
+		return nullptr;
+	}
+
+	// reserve the address range for both halves first, then map the memory over it.
+	void* base = mmap(nullptr, (2 * capacity), PROT_NONE, (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+	if (base == MAP_FAILED) {
+		close(fd);
+		return nullptr;
+	}
+
+	std::uint8_t* buffer = static_cast<std::uint8_t*>(base);
+	const bool mapped = (
+		(mmap(buffer, capacity, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_FIXED), fd, 0) != MAP_FAILED) &&
+		(mmap((buffer + capacity), capacity, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_FIXED), fd, 0) != MAP_FAILED)
+	);
+
+	close(fd);
+
+	if (!mapped) {
+		munmap(base, (2 * capacity));
+		return nullptr;
+	}
+
+	return buffer;
+}
+
+#endif
+
+BufferedSocketStream::BufferedSocketStream(const Socket& socket) : BufferedSocketStream(socket, DEFAULT_CAPACITY) { }
+
+BufferedSocketStream::BufferedSocketStream(const Socket& socket, const std::size_t capacity) : BufferedSocketStream(socket, capacity, true) { }
+
+BufferedSocketStream::BufferedSocketStream(const Socket& socket, const std::size_t capacity, const bool mirrored) 
+	: m_socket(&socket), m_buffer(nullptr), m_capacity(0), m_mirrored(false), m_readPos(0), m_writePos(0) {
+
+	if (capacity == 0)
+		throw std::invalid_argument(ERR_CAPACITY_ZERO.data());
+
+	this->m_capacity = std::bit_ceil(capacity);
+
+#ifndef NE_PLATFORM_WINDOWS
+	if (mirrored) {
+
+		// both halves have to be whole pages.
+		const std::size_t pageSize = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+		const std::size_t mirroredCapacity = std::max(this->m_capacity, std::bit_ceil(pageSize));
+
+		this->m_buffer = CreateMirroredBuffer(mirroredCapacity);
+		if (this->m_buffer != nullptr) {
+			this->m_capacity = mirroredCapacity;
+			this->m_mirrored = true;
+		}
+
+	}
+#endif
+
+	if (this->m_buffer == nullptr)
+		this->m_buffer = new std::uint8_t[this->m_capacity];
+
+}
+
+BufferedSocketStream::~BufferedSocketStream() {
+
+#ifndef NE_PLATFORM_WINDOWS
+	if (this->m_mirrored) munmap(this->m_buffer, (2 * this->m_capacity));
+	else delete[] this->m_buffer;
+#else
+	delete[] this->m_buffer;
+#endif
+
+	this->m_buffer = nullptr;
+
+}
+
+const Socket& BufferedSocketStream::GetSocket() const {
+	return *this->m_socket;
+}
+
+std::size_t BufferedSocketStream::GetCapacity() const {
+	return this->m_capacity;
+}
+
+std::size_t BufferedSocketStream::GetBufferedSize() const {
+	return (this->m_writePos - this->m_readPos);
+}
+
+bool BufferedSocketStream::IsMirrored() const {
+	return this->m_mirrored;
+}
+
+// reads as much as fits in the free part of the ring with a single receive call.
+// returns the number of bytes read, or 0 if the peer has closed the connection.
+std::int32_t BufferedSocketStream::Fill() {
+
+	const std::span<std::uint8_t> free = this->GetWritableSpan();
+	if (free.empty())
+		throw std::runtime_error(ERR_BUFFER_FULL.data());
+
+	const std::int32_t size = static_cast<std::int32_t>(std::min<std::size_t>(free.size(), std::numeric_limits<std::int32_t>::max()));
+	const std::int32_t read = this->m_socket->Receive(free, size);
+	this->Commit(static_cast<std::size_t>(read));
+
+	return read;
+}
+
+// Fill for non-blocking sockets. 0 bytes read and no error means the peer has closed the connection.
+// a full buffer is reported as ENOBUFS (WSAENOBUFS on Windows), without receiving: the data has to be consumed first.
+SocketResult BufferedSocketStream::TryFill() noexcept {
+
+	const std::span<std::uint8_t> free = this->GetWritableSpan();
+	if (free.empty()) {
+#ifdef NE_PLATFORM_WINDOWS
+		return { 0, WSAENOBUFS, false, 0 };
+#else
+		return { 0, ENOBUFS, false, 0 };
+#endif
+	}
+
+	const std::int32_t size = static_cast<std::int32_t>(std::min<std::size_t>(free.size(), std::numeric_limits<std::int32_t>::max()));
+	const SocketResult result = this->m_socket->TryReceive(free, size);
+	if (result.Bytes > 0) this->Commit(static_cast<std::size_t>(result.Bytes));
+
+	return result;
+}
+
+// returns all buffered data, without consuming it.
+std::span<const std::uint8_t> BufferedSocketStream::Peek() const {
+	return { (this->m_buffer + this->m_readPos), this->GetBufferedSize() };
+}
+
+// reads until the delimiter has been received, and returns (and consumes) the data up to and including it.
+std::span<const std::uint8_t> BufferedSocketStream::ReadUntil(const std::string_view delimiter) {
+
+	if (delimiter.empty())
+		throw std::invalid_argument(ERR_EMPTY_DELIMITER.data());
+
+	// data that was already searched is not searched again after each fill.
+	std::size_t searched = 0;
+
+	while (true) {
+
+		const std::span<const std::uint8_t> data = this->Peek();
+		const std::string_view view(reinterpret_cast<const char*>(data.data()), data.size());
+
+		const std::size_t pos = view.find(delimiter, searched);
+		if (pos != std::string_view::npos) {
+			const std::span<const std::uint8_t> result = data.first(pos + delimiter.size());
+			this->Consume(result.size());
+			return result;
+		}
+
+		searched = ((data.size() >= delimiter.size()) ? (data.size() - delimiter.size() + 1) : 0);
+
+		if (this->Fill() == 0)
+			throw std::runtime_error(ERR_END_OF_STREAM.data());
+
+	}
+
+}
+
+// reads until at least size bytes are buffered, and returns (and consumes) the first size bytes.
+std::span<const std::uint8_t> BufferedSocketStream::ReadExact(const std::size_t size) {
+
+	if (size > this->m_capacity)
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_CAPACITY.data());
+
+	while (this->GetBufferedSize() < size)
+		if (this->Fill() == 0)
+			throw std::runtime_error(ERR_END_OF_STREAM.data());
+
+	const std::span<const std::uint8_t> result = this->Peek().first(size);
+	this->Consume(size);
+
+	return result;
+}
+
+// discards size bytes of buffered data.
+void BufferedSocketStream::Consume(const std::size_t size) {
+
+	if (size > this->GetBufferedSize())
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERED.data());
+
+	this->m_readPos += size;
+
+	if (this->m_readPos == this->m_writePos) {
+		this->m_readPos = 0;
+		this->m_writePos = 0;
+	}
+	else if (this->m_mirrored && (this->m_readPos >= this->m_capacity)) {
+		// the data is mirrored, so both positions can be moved back into the first half.
+		this->m_readPos -= this->m_capacity;
+		this->m_writePos -= this->m_capacity;
+	}
+
+}
+
+std::span<std::uint8_t> BufferedSocketStream::GetWritableSpan() noexcept {
+
+	if (this->m_mirrored)
+		return { (this->m_buffer + this->m_writePos), (this->m_capacity - this->GetBufferedSize()) };
+
+	// without the mirror, the unread data is moved to the front to make room at the end.
+	if (this->m_readPos > 0) {
+		std::memmove(this->m_buffer, (this->m_buffer + this->m_readPos), this->GetBufferedSize());
+		this->m_writePos -= this->m_readPos;
+		this->m_readPos = 0;
+	}
+
+	return { (this->m_buffer + this->m_writePos), (this->m_capacity - this->m_writePos) };
+}
+
+void BufferedSocketStream::Commit(const std::size_t size) noexcept {
+	this->m_writePos += size;
+}
\ No newline at end of file
@@ -0,0 +1,155 @@
+#include <Vnetworking/Sockets/ConnectionDispatcher.h>
+#include <Vnetworking/Sockets/SocketException.h>
+#include "Native.h"
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using namespace Vnetworking::Sockets;
+using namespace Vnetworking::Sockets::Private;
+
+constexpr std::string_view ERR_BAD_WORKER_COUNT = "Cannot create a connection dispatcher with zero or less workers.";
+constexpr std::string_view ERR_WORKER_OUT_OF_RANGE = "'worker' is out of range.";
+constexpr std::string_view ERR_ALREADY_RUNNING = "The connection dispatcher is already running.";
+
+ConnectionDispatcher::ConnectionDispatcher(const std::int32_t workerCount) {
+
+	if (workerCount < 1)
+		throw std::invalid_argument(ERR_BAD_WORKER_COUNT.data());
+
+	this->m_workerCount = workerCount;
+	this->m_nextWorker = 0;
+	this->m_running = false;
+
+	this->m_queues.reserve(workerCount);
+	for (std::int32_t i = 0; i < workerCount; ++i)
+		this->m_queues.push_back(std::make_unique<WorkerQueue>());
+
+	// the CPU every worker is pinned to, and the workers pinned to every CPU.
+	const std::uint32_t cpuCount = std::max<std::uint32_t>(std::thread::hardware_concurrency(), 1);
+	this->m_cpuWorkers.resize(cpuCount);
+	this->m_workerCpus.reserve(workerCount);
+
+	for (std::int32_t i = 0; i < workerCount; ++i) {
+		const std::uint32_t cpu = (static_cast<std::uint32_t>(i) % cpuCount);
+		this->m_workerCpus.push_back(cpu);
+		this->m_cpuWorkers[cpu].push_back(i);
+	}
+
+}
+
+ConnectionDispatcher::ConnectionDispatcher()
+	: ConnectionDispatcher(std::max<std::int32_t>(std::thread::hardware_concurrency(), 1)) { }
+
+ConnectionDispatcher::~ConnectionDispatcher() {
+	this->Stop();
+}
+
+std::int32_t ConnectionDispatcher::GetWorkerCount() const {
+	return this->m_workerCount;
+}
+
+std::uint32_t ConnectionDispatcher::GetWorkerCpu(const std::int32_t worker) const {
+
+	if ((worker < 0) || (worker >= this->m_workerCount))
+		throw std::out_of_range(ERR_WORKER_OUT_OF_RANGE.data());
+
+	return this->m_workerCpus[worker];
+}
+
+void ConnectionDispatcher::Start(const ConnectionHandler& handler) {
+
+	if (this->m_running.exchange(true))
+		throw std::runtime_error(ERR_ALREADY_RUNNING.data());
+
+	this->m_workers.reserve(this->m_workerCount);
+	for (std::int32_t i = 0; i < this->m_workerCount; ++i)
+		this->m_workers.push_back(std::thread(&ConnectionDispatcher::WorkerThreadProc, this, i, handler));
+
+}
+
+// stops the workers. connections that weren't handled yet are closed.
+void ConnectionDispatcher::Stop() {
+
+	this->m_running = false;
+
+	// the flag is published under each queue's lock, so a worker can't miss the wakeup.
+	for (const std::unique_ptr<WorkerQueue>& queue : this->m_queues) {
+		const std::lock_guard<std::mutex> lock(queue->Mutex);
+		queue->Condition.notify_all();
+	}
+
+	for (std::thread& worker : this->m_workers)
+		worker.join();
+
+	this->m_workers.clear();
+
+	for (const std::unique_ptr<WorkerQueue>& queue : this->m_queues)
+		queue->Connections.clear();
+
+}
+
+// dispatches a connection to the worker pinned to the CPU that received it,
+// and returns the index of that worker.
+std::int32_t ConnectionDispatcher::Dispatch(Socket&& socket) {
+
+	std::int32_t cpu = -1;
+
+	try { cpu = socket.GetIncomingCpu(); }
+	catch (const SocketException&) { }
+
+	// only a worker pinned to the connection's CPU keeps the connection on that CPU.
+	// if there's more than one, they take turns.
+	const std::vector<std::int32_t>* candidates = nullptr;
+	if ((cpu >= 0) && (static_cast<std::size_t>(cpu) < this->m_cpuWorkers.size()) && !this->m_cpuWorkers[cpu].empty())
+		candidates = &this->m_cpuWorkers[cpu];
+
+	std::int32_t worker;
+	if (candidates == nullptr) worker = static_cast<std::int32_t>(this->m_nextWorker++ % static_cast<std::uint32_t>(this->m_workerCount));
+	else if (candidates->size() == 1) worker = candidates->front();
+	else worker = (*candidates)[this->m_nextWorker++ % candidates->size()];
+
+	this->Dispatch(worker, std::move(socket));
+
+	return worker;
+}
+
+void ConnectionDispatcher::Dispatch(const std::int32_t worker, Socket&& socket) {
+
+	if ((worker < 0) || (worker >= this->m_workerCount))
+		throw std::out_of_range(ERR_WORKER_OUT_OF_RANGE.data());
+
+	WorkerQueue& queue = *this->m_queues[worker];
+
+	{
+		const std::lock_guard<std::mutex> lock(queue.Mutex);
+		queue.Connections.push_back(std::move(socket));
+	}
+
+	queue.Condition.notify_one();
+
+}
+
+void ConnectionDispatcher::WorkerThreadProc(const std::int32_t worker, const ConnectionHandler handler) {
+
+	PinCurrentThread(this->m_workerCpus[worker]);
+
+	WorkerQueue& queue = *this->m_queues[worker];
+	while (true) {
+
+		std::unique_lock<std::mutex> lock(queue.Mutex);
+		queue.Condition.wait(lock, [this, &queue] () { return (!this->m_running || !queue.Connections.empty()); });
+		if (!this->m_running) break;
+
+		Socket socket = std::move(queue.Connections.front());
+		queue.Connections.pop_front();
+		lock.unlock();
+
+		// an exception from the handler would terminate the process, so it only closes the connection.
+		try { handler(worker, std::move(socket)); }
+		catch (...) { }
+
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include <Vnetworking/Sockets/ConnectionPool.h>
+#include <Vnetworking/Sockets/SocketException.h>
+
+#include <vector>
+#include <exception>
+#include <stdexcept>
+
+using namespace Vnetworking;
+using namespace Vnetworking::Sockets;
+
+typedef std::chrono::steady_clock Clock;
+
+constexpr std::string_view ERR_BAD_MAX_IDLE = "'maxIdle' is less than zero.";
+constexpr std::string_view ERR_BAD_MAX_IDLE_PER_HOST = "'maxIdlePerHost' is less than zero.";
+constexpr std::string_view ERR_BAD_IDLE_TIMEOUT = "'idleTimeout' is less than or equal to zero.";
+constexpr std::string_view ERR_BAD_SOCKET = "Invalid socket.";
+
+constexpr std::int32_t DEFAULT_MAX_IDLE = 256;
+constexpr std::int32_t DEFAULT_MAX_IDLE_PER_HOST = 16;
+constexpr std::int32_t DEFAULT_IDLE_TIMEOUT = 60000;
+
+static std::string CreateKey(const IpSocketAddress& endpoint) {
+	
+	const IpAddress address = endpoint.GetIpAddress();
+	if (address.IsVersion6()) return ("[" + address.ToString() + "]:" + std::to_string(endpoint.GetPort()));
+	
+	return (address.ToString() + ":" + std::to_string(endpoint.GetPort()));
+}
+
+static std::string CreateKey(const std::string& hostname, const Port port) {
+	return (hostname + ":" + std::to_string(port));
+}
+
+// an idle connection is considered dead if it became readable: either the peer closed
+// the connection (GetAvailableBytes is 0), or it sent data nobody asked for.
+static bool IsAlive(const Socket& connection) noexcept {
+	try { return !connection.Poll(PollEvents::READ, 0); }
+	catch (const SocketException&) { return false; }
+}
+
+ConnectionPool::ConnectionPool() : ConnectionPool(DEFAULT_MAX_IDLE, DEFAULT_MAX_IDLE_PER_HOST, DEFAULT_IDLE_TIMEOUT) { }
+
+ConnectionPool::ConnectionPool(const std::int32_t maxIdle, const std::int32_t maxIdlePerHost, const std::int32_t idleTimeout)
+	: ConnectionPool(maxIdle, maxIdlePerHost, idleTimeout, Connector()) { }
+
+ConnectionPool::ConnectionPool(const std::int32_t maxIdle, const std::int32_t maxIdlePerHost, const std::int32_t idleTimeout, const Connector& connector) {
+
+	if (maxIdle < 0)
+		throw std::out_of_range(ERR_BAD_MAX_IDLE.data());
+
+	if (maxIdlePerHost < 0)
+		throw std::out_of_range(ERR_BAD_MAX_IDLE_PER_HOST.data());
+
+	if (idleTimeout <= 0)
+		throw std::out_of_range(ERR_BAD_IDLE_TIMEOUT.data());
+
+	this->m_maxIdle = maxIdle;
+	this->m_maxIdlePerHost = maxIdlePerHost;
+	this->m_idleTimeout = idleTimeout;
+	this->m_connector = connector;
+
+	this->m_idleCount = 0;
+	this->m_statistics = { 0, 0, 0, 0 };
+
+}
+
+ConnectionPool::~ConnectionPool() { }
+
+std::optional<Socket> ConnectionPool::TakeIdleConnection(const std::string& key) {
+
+	std::vector<Socket> dead;
+	std::optional<Socket> connection;
+
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+		
+		auto it = this->m_connections.find(key);
+		if (it != this->m_connections.end()) {
+
+			std::deque<IdleConnection>& idle = it->second;
+			const Clock::time_point expiry = (Clock::now() - std::chrono::milliseconds(this->m_idleTimeout));
+
+			while (!idle.empty() && !connection.has_value()) {
+
+				IdleConnection entry = std::move(idle.back());
+				idle.pop_back();
+				--this->m_idleCount;
+
+				if ((entry.ReleaseTime > expiry) && IsAlive(entry.Connection)) connection.emplace(std::move(entry.Connection));
+				else {
+					dead.push_back(std::move(entry.Connection));
+					++this->m_statistics.Expired;
+				}
+
+			}
+
+			if (idle.empty()) this->m_connections.erase(it);
+
+		}
+
+		if (connection.has_value()) ++this->m_statistics.Hits;
+		else ++this->m_statistics.Misses;
+
+	}
+
+	// the dead connections are closed here, outside of the lock.
+	return connection;
+}
+
+void ConnectionPool::ReturnIdleConnection(const std::string& key, Socket&& connection) {
+
+	if (connection.GetNativeSocketHandle() == INVALID_SOCKET_HANDLE)
+		throw std::invalid_argument(ERR_BAD_SOCKET.data());
+
+	std::optional<Socket> discarded;
+
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+		std::deque<IdleConnection>& idle = this->m_connections[key];
+		if ((this->m_idleCount >= this->m_maxIdle) || (idle.size() >= static_cast<std::size_t>(this->m_maxIdlePerHost))) {
+			
+			discarded.emplace(std::move(connection));
+			++this->m_statistics.Discarded;
+			
+			if (idle.empty()) this->m_connections.erase(key);
+
+		}
+		else {
+			idle.push_back({ std::move(connection), Clock::now() });
+			++this->m_idleCount;
+		}
+
+	}
+
+}
+
+Socket ConnectionPool::Acquire(const IpSocketAddress& endpoint) {
+
+	std::optional<Socket> connection = this->TakeIdleConnection(CreateKey(endpoint));
+	if (connection.has_value()) return std::move(*connection);
+
+	return this->m_connector.Connect(std::vector<IpAddress> { endpoint.GetIpAddress() }, endpoint.GetPort());
+}
+
+Socket ConnectionPool::Acquire(const std::string& hostname, const Port port) {
+
+	std::optional<Socket> connection = this->TakeIdleConnection(CreateKey(hostname, port));
+	if (connection.has_value()) return std::move(*connection);
+
+	return this->m_connector.Connect(hostname, port);
+}
+
+void ConnectionPool::Release(const IpSocketAddress& endpoint, Socket&& connection) {
+	this->ReturnIdleConnection(CreateKey(endpoint), std::move(connection));
+}
+
+void ConnectionPool::Release(const std::string& hostname, const Port port, Socket&& connection) {
+	this->ReturnIdleConnection(CreateKey(hostname, port), std::move(connection));
+}
+
+void ConnectionPool::Prune() {
+
+	std::vector<Socket> dead;
+
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+		const Clock::time_point expiry = (Clock::now() - std::chrono::milliseconds(this->m_idleTimeout));
+
+		for (auto it = this->m_connections.begin(); it != this->m_connections.end();) {
+
+			std::deque<IdleConnection>& idle = it->second;
+			for (auto entry = idle.begin(); entry != idle.end();) {
+
+				if ((entry->ReleaseTime > expiry) && IsAlive(entry->Connection)) {
+					++entry;
+					continue;
+				}
+
+				dead.push_back(std::move(entry->Connection));
+				entry = idle.erase(entry);
+				--this->m_idleCount;
+				++this->m_statistics.Expired;
+
+			}
+
+			if (idle.empty()) it = this->m_connections.erase(it);
+			else ++it;
+
+		}
+
+	}
+
+}
+
+void ConnectionPool::Clear() {
+
+	std::unordered_map<std::string, std::deque<IdleConnection>> connections;
+
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+		connections = std::move(this->m_connections);
+		this->m_connections.clear();
+		this->m_idleCount = 0;
+	}
+
+}
+
+std::int32_t ConnectionPool::GetIdleCount() const {
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->m_idleCount;
+}
+
+ConnectionPoolStatistics ConnectionPool::GetStatistics() const {
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->m_statistics;
+}
\ No newline at end of file
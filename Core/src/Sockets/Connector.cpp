@@ -0,0 +1,244 @@
+#include <Vnetworking/Sockets/Connector.h>
+#include <Vnetworking/Sockets/IpSocketAddress.h>
+#include <Vnetworking/Sockets/SocketException.h>
+#include <Vnetworking/Dns/DNS.h>
+#include "Native.h"
+
+#include <chrono>
+#include <optional>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using namespace Vnetworking;
+using namespace Vnetworking::Dns;
+using namespace Vnetworking::Sockets;
+using namespace Vnetworking::Sockets::Private;
+
+typedef std::chrono::steady_clock Clock;
+
+constexpr std::string_view ERR_NO_ADDRESSES = "There are no addresses to connect to.";
+constexpr std::string_view ERR_BAD_ATTEMPT_DELAY = "'attemptDelay' is less than zero.";
+constexpr std::string_view ERR_BAD_TIMEOUT = "'timeout' is less than or equal to zero.";
+
+// the connection attempt delay (in milliseconds) recommended by RFC 8305.
+constexpr std::int32_t DEFAULT_ATTEMPT_DELAY = 250;
+constexpr std::int32_t DEFAULT_TIMEOUT = 30000;
+
+#ifdef NE_PLATFORM_WINDOWS
+constexpr std::int32_t ERR_CONNECT_IN_PROGRESS = WSAEWOULDBLOCK;
+constexpr std::int32_t ERR_CONNECT_TIMED_OUT = WSAETIMEDOUT;
+#else
+constexpr std::int32_t ERR_CONNECT_IN_PROGRESS = EINPROGRESS;
+constexpr std::int32_t ERR_CONNECT_TIMED_OUT = ETIMEDOUT;
+#endif
+
+Connector::Connector() : Connector(DEFAULT_ATTEMPT_DELAY, DEFAULT_TIMEOUT) { }
+
+Connector::Connector(const std::int32_t attemptDelay, const std::int32_t timeout) {
+	this->SetConnectionAttemptDelay(attemptDelay);
+	this->SetTimeout(timeout);
+}
+
+Connector::Connector(const Connector& connector) {
+	this->operator= (connector);
+}
+
+Connector::~Connector() { }
+
+Connector& Connector::operator= (const Connector& connector) {
+
+	this->m_attemptDelay = connector.m_attemptDelay;
+	this->m_timeout = connector.m_timeout;
+
+	return static_cast<Connector&>(*this);
+}
+
+std::int32_t Connector::GetConnectionAttemptDelay() const {
+	return this->m_attemptDelay;
+}
+
+std::int32_t Connector::GetTimeout() const {
+	return this->m_timeout;
+}
+
+void Connector::SetConnectionAttemptDelay(const std::int32_t attemptDelay) {
+
+	if (attemptDelay < 0)
+		throw std::out_of_range(ERR_BAD_ATTEMPT_DELAY.data());
+
+	this->m_attemptDelay = attemptDelay;
+
+}
+
+void Connector::SetTimeout(const std::int32_t timeout) {
+
+	if (timeout <= 0)
+		throw std::out_of_range(ERR_BAD_TIMEOUT.data());
+
+	this->m_timeout = timeout;
+
+}
+
+// orders the addresses so that address families alternate, starting with the family of the first address (RFC 8305, section 4).
+static std::vector<IpAddress> InterleaveAddresses(const std::vector<IpAddress>& addresses) {
+
+	const bool preferVersion6 = addresses.front().IsVersion6();
+
+	std::vector<IpAddress> preferred, other;
+	for (const IpAddress& address : addresses) {
+		if (address.IsVersion6() == preferVersion6) preferred.push_back(address);
+		else other.push_back(address);
+	}
+
+	std::vector<IpAddress> ordered;
+	ordered.reserve(addresses.size());
+
+	for (std::size_t i = 0; i < std::max(preferred.size(), other.size()); ++i) {
+		if (i < preferred.size()) ordered.push_back(preferred[i]);
+		if (i < other.size()) ordered.push_back(other[i]);
+	}
+
+	return ordered;
+}
+
+// starts a non-blocking connect. returns 0 if the connection is established or in progress,
+// otherwise the error code the attempt failed with.
+static std::int32_t BeginConnect(const IpAddress& address, const Port port, std::optional<Socket>& socket, bool& connected) {
+
+	const IpSocketAddress sockaddr = { address, port };
+	connected = false;
+
+	try {
+		socket.emplace(sockaddr.GetAddressFamily(), SocketType::STREAM, ProtocolType::TCP);
+		socket->SetBlocking(false);
+	}
+	catch (const SocketException& ex) {
+		socket.reset();
+		return ex.GetErrorCode();
+	}
+
+	const NativeHandle_t handle = ToNativeHandle(socket->GetNativeSocketHandle());
+	const struct sockaddr* name = reinterpret_cast<const struct sockaddr*>(sockaddr.GetNativeSocketAddress());
+
+	if (connect(handle, name, sockaddr.GetNativeSocketAddressLength()) == SOCKET_ERROR) {
+		
+		const std::int32_t err = GetLastSocketError();
+		if (err == ERR_CONNECT_IN_PROGRESS) return 0;
+
+		socket.reset();
+		return err;
+	}
+
+	connected = true;
+	return 0;
+}
+
+// returns the result of a finished non-blocking connect (0 if the connection was established).
+static std::int32_t GetConnectResult(const Socket& socket) {
+
+	int err = 0;
+	socklen_t errLen = sizeof(err);
+	if (getsockopt(ToNativeHandle(socket.GetNativeSocketHandle()), SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&err), &errLen) == SOCKET_ERROR)
+		return GetLastSocketError();
+
+	return static_cast<std::int32_t>(err);
+}
+
+Socket Connector::Connect(const std::vector<IpAddress>& addresses, const Port port) const {
+
+	if (addresses.empty())
+		throw std::invalid_argument(ERR_NO_ADDRESSES.data());
+
+	const std::vector<IpAddress> ordered = InterleaveAddresses(addresses);
+	const Clock::time_point deadline = (Clock::now() + std::chrono::milliseconds(this->m_timeout));
+
+	std::vector<Socket> pending;
+	std::vector<NativePollFd_t> fds;
+	std::size_t next = 0;
+	std::int32_t lastError = ERR_CONNECT_TIMED_OUT;
+	Clock::time_point nextAttempt = Clock::now();
+
+	while (true) {
+
+		const Clock::time_point now = Clock::now();
+		if (now >= deadline) break;
+
+		// start the next attempt once the attempt delay has passed, or right away if all earlier attempts have failed.
+		if ((next < ordered.size()) && ((now >= nextAttempt) || pending.empty())) {
+
+			std::optional<Socket> socket;
+			bool connected = false;
+
+			const std::int32_t err = BeginConnect(ordered[next++], port, socket, connected);
+			if (err != 0) {
+				lastError = err;
+				continue;
+			}
+
+			if (connected) {
+				socket->SetBlocking(true);
+				return std::move(*socket);
+			}
+
+			pending.push_back(std::move(*socket));
+			nextAttempt = (now + std::chrono::milliseconds(this->m_attemptDelay));
+			continue;
+		}
+
+		if (pending.empty()) break;
+
+		// wait until an attempt finishes, the next attempt is due, or time runs out.
+		Clock::time_point wakeup = deadline;
+		if (next < ordered.size()) wakeup = std::min(wakeup, nextAttempt);
+
+		const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(wakeup - now).count();
+
+		fds.resize(pending.size());
+		for (std::size_t i = 0; i < pending.size(); ++i) {
+			fds[i] = { };
+			fds[i].fd = ToNativeHandle(pending[i].GetNativeSocketHandle());
+			fds[i].events = POLLWRNORM;
+		}
+
+		if (PollNativeSockets(fds.data(), static_cast<std::uint32_t>(fds.size()), static_cast<std::int32_t>(timeout)) == SOCKET_ERROR) {
+
+			// a signal interrupted the wait: poll again with the time that's left.
+			const std::int32_t err = GetLastSocketError();
+#ifdef NE_PLATFORM_WINDOWS
+			if (err == WSAEINTR) continue;
+#else
+			if (err == EINTR) continue;
+#endif
+
+			throw SocketException(err);
+		}
+
+		for (std::size_t i = pending.size(); i-- > 0;) {
+
+			if (fds[i].revents == 0) continue;
+
+			const std::int32_t err = GetConnectResult(pending[i]);
+			if (err == 0) {
+				pending[i].SetBlocking(true);
+				return std::move(pending[i]);
+			}
+
+			lastError = err;
+			pending.erase(pending.begin() + i);
+
+		}
+
+	}
+
+	// the remaining attempts are closed when the pending sockets are destroyed.
+	throw SocketException(pending.empty() ? lastError : ERR_CONNECT_TIMED_OUT);
+}
+
+Socket Connector::Connect(const DnsLookupResult& lookupResult, const Port port) const {
+	return this->Connect(lookupResult.GetAddresses(), port);
+}
+
+Socket Connector::Connect(const std::string& hostname, const Port port) const {
+	return this->Connect(DNS::Resolve(hostname), port);
+}
\ No newline at end of file
@@ -0,0 +1,238 @@
+#include <Vnetworking/Sockets/EventLoop.h>
+#include <Vnetworking/Sockets/SocketException.h>
+#include "Native.h"
+
+#ifndef NE_PLATFORM_WINDOWS
+#include <sys/epoll.h>
+#endif
+
+#include <vector>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using namespace Vnetworking::Sockets;
+using namespace Vnetworking::Sockets::Private;
+
+constexpr std::string_view ERR_BAD_SOCKET = "Invalid socket.";
+constexpr std::string_view ERR_SOCKET_NOT_REGISTERED = "The socket is not registered with this event loop.";
+constexpr std::string_view ERR_SOCKET_ALREADY_REGISTERED = "The socket is already registered with this event loop.";
+
+#ifndef NE_PLATFORM_WINDOWS
+
+// the maximum number of epoll events fetched with one epoll_wait call.
+constexpr std::size_t MAX_EVENTS_PER_WAIT = 1024;
+
+static std::uint32_t ToNativeEvents(const PollEvents events) noexcept {
+
+	std::uint32_t nativeEvents = EPOLLET;
+
+	if (static_cast<bool>(events & PollEvents::READ)) nativeEvents |= (EPOLLIN | EPOLLRDHUP);
+	if (static_cast<bool>(events & PollEvents::WRITE)) nativeEvents |= EPOLLOUT;
+
+	// EPOLLERR and EPOLLHUP are always reported by epoll.
+	return nativeEvents;
+}
+
+static PollEvents FromNativeEvents(const std::uint32_t nativeEvents) noexcept {
+
+	PollEvents events = PollEvents::NONE;
+
+	if (nativeEvents & EPOLLIN) events |= PollEvents::READ;
+	if (nativeEvents & EPOLLOUT) events |= PollEvents::WRITE;
+	if (nativeEvents & EPOLLERR) events |= PollEvents::ERROR;
+	if (nativeEvents & (EPOLLHUP | EPOLLRDHUP)) events |= PollEvents::HANGUP;
+
+	return events;
+}
+
+static void EpollControl(const std::int32_t epoll, const int op, const Socket& socket, const PollEvents events, const std::uint64_t userData) {
+
+	if (socket.GetNativeSocketHandle() == INVALID_SOCKET_HANDLE)
+		throw std::invalid_argument(ERR_BAD_SOCKET.data());
+
+	struct epoll_event ev = { };
+	ev.events = ToNativeEvents(events);
+	ev.data.u64 = userData;
+
+	if (epoll_ctl(epoll, op, ToNativeHandle(socket.GetNativeSocketHandle()), &ev) == -1)
+		throw SocketException(GetLastSocketError());
+
+}
+
+EventLoop::EventLoop() {
+	this->m_epoll = epoll_create1(EPOLL_CLOEXEC);
+	if (this->m_epoll == -1)
+		throw SocketException(GetLastSocketError());
+}
+
+EventLoop::~EventLoop() {
+	close(this->m_epoll);
+	this->m_epoll = -1;
+}
+
+void EventLoop::Add(const Socket& socket, const PollEvents events, const std::uint64_t userData) {
+	EpollControl(this->m_epoll, EPOLL_CTL_ADD, socket, events, userData);
+}
+
+void EventLoop::Modify(const Socket& socket, const PollEvents events, const std::uint64_t userData) {
+	EpollControl(this->m_epoll, EPOLL_CTL_MOD, socket, events, userData);
+}
+
+void EventLoop::Remove(const Socket& socket) {
+
+	if (socket.GetNativeSocketHandle() == INVALID_SOCKET_HANDLE)
+		throw std::invalid_argument(ERR_BAD_SOCKET.data());
+
+	if (epoll_ctl(this->m_epoll, EPOLL_CTL_DEL, ToNativeHandle(socket.GetNativeSocketHandle()), nullptr) == -1)
+		throw SocketException(GetLastSocketError());
+
+}
+
+std::int32_t EventLoop::Wait(const std::span<SocketEvent>& events, const std::int32_t timeout) const {
+
+	if (events.empty()) return 0;
+
+	struct epoll_event nativeEvents[MAX_EVENTS_PER_WAIT];
+	const int maxEvents = static_cast<int>(std::min(events.size(), MAX_EVENTS_PER_WAIT));
+
+	int count = 0;
+	do count = epoll_wait(this->m_epoll, nativeEvents, maxEvents, timeout);
+	while ((count == -1) && (errno == EINTR));
+
+	if (count == -1)
+		throw SocketException(GetLastSocketError());
+
+	for (int i = 0; i < count; ++i) {
+		events[i].Events = FromNativeEvents(nativeEvents[i].events);
+		events[i].UserData = nativeEvents[i].data.u64;
+	}
+
+	return static_cast<std::int32_t>(count);
+}
+
+#else
+
+static std::int16_t ToNativeEvents(const PollEvents events) noexcept {
+
+	std::int16_t nativeEvents = 0;
+
+	if (static_cast<bool>(events & PollEvents::READ)) nativeEvents |= POLLRDNORM;
+	if (static_cast<bool>(events & PollEvents::WRITE)) nativeEvents |= POLLWRNORM;
+
+	return nativeEvents;
+}
+
+static PollEvents FromNativeEvents(const std::int16_t nativeEvents) noexcept {
+
+	PollEvents events = PollEvents::NONE;
+
+	if (nativeEvents & POLLRDNORM) events |= PollEvents::READ;
+	if (nativeEvents & POLLWRNORM) events |= PollEvents::WRITE;
+	if (nativeEvents & (POLLERR | POLLNVAL)) events |= PollEvents::ERROR;
+	if (nativeEvents & POLLHUP) events |= PollEvents::HANGUP;
+
+	return events;
+}
+
+EventLoop::EventLoop() { }
+
+EventLoop::~EventLoop() { }
+
+void EventLoop::Add(const Socket& socket, const PollEvents events, const std::uint64_t userData) {
+
+	if (socket.GetNativeSocketHandle() == INVALID_SOCKET_HANDLE)
+		throw std::invalid_argument(ERR_BAD_SOCKET.data());
+
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	if (this->m_sockets.contains(socket.GetNativeSocketHandle()))
+		throw std::invalid_argument(ERR_SOCKET_ALREADY_REGISTERED.data());
+
+	this->m_sockets[socket.GetNativeSocketHandle()] = { events, userData };
+
+}
+
+void EventLoop::Modify(const Socket& socket, const PollEvents events, const std::uint64_t userData) {
+
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	if (!this->m_sockets.contains(socket.GetNativeSocketHandle()))
+		throw std::invalid_argument(ERR_SOCKET_NOT_REGISTERED.data());
+
+	this->m_sockets[socket.GetNativeSocketHandle()] = { events, userData };
+
+}
+
+void EventLoop::Remove(const Socket& socket) {
+
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	if (this->m_sockets.erase(socket.GetNativeSocketHandle()) == 0)
+		throw std::invalid_argument(ERR_SOCKET_NOT_REGISTERED.data());
+
+}
+
+std::int32_t EventLoop::Wait(const std::span<SocketEvent>& events, const std::int32_t timeout) const {
+
+	if (events.empty()) return 0;
+
+	std::vector<NativePollFd_t> fds;
+	std::vector<std::uint64_t> userData;
+
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+		fds.reserve(this->m_sockets.size());
+		userData.reserve(this->m_sockets.size());
+
+		for (const auto& [socket, registration] : this->m_sockets) {
+			NativePollFd_t fd = { };
+			fd.fd = ToNativeHandle(socket);
+			fd.events = ToNativeEvents(registration.first);
+			fds.push_back(fd);
+			userData.push_back(registration.second);
+		}
+	}
+
+	// WSAPoll fails when called without any sockets.
+	if (fds.empty()) {
+		if (timeout != 0) Sleep((timeout < 0) ? INFINITE : static_cast<DWORD>(timeout));
+		return 0;
+	}
+
+	int result = PollNativeSockets(fds.data(), static_cast<std::uint32_t>(fds.size()), timeout);
+	if (result == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	std::int32_t count = 0;
+	for (std::size_t i = 0; (i < fds.size()) && (count < static_cast<std::int32_t>(events.size())); ++i) {
+
+		if (fds[i].revents == 0) continue;
+
+		events[count].Events = FromNativeEvents(fds[i].revents);
+		events[count].UserData = userData[i];
+		++count;
+
+	}
+
+	return count;
+}
+
+#endif
+
+void EventLoop::Add(const Socket& socket, const PollEvents events) {
+	this->Add(socket, events, socket.GetNativeSocketHandle());
+}
+
+void EventLoop::Modify(const Socket& socket, const PollEvents events) {
+	this->Modify(socket, events, socket.GetNativeSocketHandle());
+}
+
+// waits for socket events, but no longer than until the next timer is due, and then fires the expired timers.
+std::int32_t EventLoop::Wait(const std::span<SocketEvent>& events, const std::int32_t timeout, TimerWheel& timers) const {
+
+	std::int32_t wait = timers.GetNextTimeout();
+	if ((wait < 0) || ((timeout >= 0) && (timeout < wait))) wait = timeout;
+
+	const std::int32_t count = this->Wait(events, wait);
+	timers.Advance();
+
+	return count;
+}
\ No newline at end of file
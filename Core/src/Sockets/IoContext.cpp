@@ -0,0 +1,205 @@
+#include <Vnetworking/Sockets/IoContext.h>
+#include <Vnetworking/Sockets/SocketException.h>
+#include "Native.h"
+
+#include <vector>
+#include <exception>
+#include <stdexcept>
+
+using namespace Vnetworking;
+using namespace Vnetworking::Sockets;
+using namespace Vnetworking::Sockets::Private;
+
+constexpr std::string_view ERR_ALREADY_WAITING = "Another coroutine is already waiting on this socket.";
+
+// the error a cancelled wait is resumed with.
+#ifdef NE_PLATFORM_WINDOWS
+constexpr std::int32_t WAIT_CANCELLED_ERROR = WSAECANCELLED;
+#else
+constexpr std::int32_t WAIT_CANCELLED_ERROR = ECANCELED;
+#endif
+
+// the maximum number of events handled per RunOnce call.
+constexpr std::size_t MAX_EVENTS_PER_RUN = 256;
+
+namespace {
+
+	// a coroutine that starts right away and destroys itself when it finishes. used by IoContext::Spawn.
+	struct DetachedTask {
+		struct promise_type {
+			DetachedTask get_return_object(void) const noexcept { return { }; }
+			std::suspend_never initial_suspend(void) const noexcept { return { }; }
+			std::suspend_never final_suspend(void) const noexcept { return { }; }
+			void return_void(void) const noexcept { }
+			void unhandled_exception(void) const noexcept { std::terminate(); }
+		};
+	};
+
+	DetachedTask RunDetached(Task<void> task) {
+		co_await task;
+	}
+
+}
+
+IoContext::ReadinessAwaiter::ReadinessAwaiter(IoContext& context, const Socket& socket, const PollEvents events) noexcept
+	: m_context(&context), m_socket(&socket), m_events(events), m_coroutine(nullptr), m_cancelled(false) { }
+
+bool IoContext::ReadinessAwaiter::await_ready() const noexcept {
+	return false;
+}
+
+void IoContext::ReadinessAwaiter::await_suspend(const std::coroutine_handle<> coroutine) {
+	this->m_coroutine = coroutine;
+	this->m_context->Suspend(*this);
+}
+
+void IoContext::ReadinessAwaiter::await_resume() const {
+	if (this->m_cancelled) throw SocketException(WAIT_CANCELLED_ERROR);
+}
+
+IoContext::DelayAwaiter::DelayAwaiter(IoContext& context, const std::int32_t delay) noexcept
+	: m_context(&context), m_delay(delay) { }
+
+bool IoContext::DelayAwaiter::await_ready() const noexcept {
+	return (this->m_delay <= 0);
+}
+
+void IoContext::DelayAwaiter::await_suspend(const std::coroutine_handle<> coroutine) {
+	this->m_context->SuspendFor(this->m_delay, coroutine);
+}
+
+void IoContext::DelayAwaiter::await_resume() const noexcept { }
+
+IoContext::IoContext() {
+	this->m_stopped = false;
+}
+
+IoContext::~IoContext() { }
+
+IoContext::ReadinessAwaiter IoContext::WaitAsync(const Socket& socket, const PollEvents events) {
+	return ReadinessAwaiter(static_cast<IoContext&>(*this), socket, events);
+}
+
+// the delay is in milliseconds. a delay of 0 or less doesn't suspend.
+IoContext::DelayAwaiter IoContext::DelayAsync(const std::int32_t delay) {
+	return DelayAwaiter(static_cast<IoContext&>(*this), delay);
+}
+
+// a spawned task runs until it first suspends, and is then driven by Run.
+// exceptions that escape a spawned task terminate the program, like exceptions that escape a thread.
+void IoContext::Spawn(Task<void>&& task) {
+	RunDetached(std::move(task));
+}
+
+void IoContext::Suspend(ReadinessAwaiter& awaiter) {
+
+	const Socket& socket = *awaiter.m_socket;
+	const NativeSocket_t handle = socket.GetNativeSocketHandle();
+	const bool registered = this->m_waiters.contains(handle);
+
+	Waiters& waiters = this->m_waiters[handle];
+	ReadinessAwaiter*& slot = (static_cast<bool>(awaiter.m_events & PollEvents::READ) ? waiters.Reader : waiters.Writer);
+
+	if (slot) throw std::logic_error(ERR_ALREADY_WAITING.data());
+
+	waiters.Target = &socket;
+	slot = &awaiter;
+
+	PollEvents interest = PollEvents::NONE;
+	if (waiters.Reader) interest |= PollEvents::READ;
+	if (waiters.Writer) interest |= PollEvents::WRITE;
+
+	try {
+		if (registered) this->m_loop.Modify(socket, interest, handle);
+		else this->m_loop.Add(socket, interest, handle);
+	}
+	catch (...) {
+		slot = nullptr;
+		if (!registered) this->m_waiters.erase(handle);
+		throw;
+	}
+
+}
+
+void IoContext::SuspendFor(const std::int32_t delay, const std::coroutine_handle<> coroutine) {
+
+	// the timer only queues the coroutine; RunOnce resumes it after the socket events were handled.
+	this->m_timers.Schedule(delay, [this, coroutine] () { this->m_ready.push_back(coroutine); });
+
+}
+
+// cancels the coroutines waiting on a socket, and removes the socket from the context.
+// they are resumed by the next RunOnce, and the waits throw a SocketException (ECANCELED, WSAECANCELLED on Windows).
+// a socket that coroutines are waiting on must be cancelled before it is closed: the event loop forgets a closed
+// socket, so its waiters would never be resumed, and a new socket reusing its handle couldn't be waited on.
+void IoContext::Cancel(const Socket& socket) {
+
+	auto it = this->m_waiters.find(socket.GetNativeSocketHandle());
+	if (it == this->m_waiters.end()) return;
+
+	for (ReadinessAwaiter* awaiter : { it->second.Reader, it->second.Writer }) {
+		if (awaiter == nullptr) continue;
+		awaiter->m_cancelled = true;
+		this->m_ready.push_back(awaiter->m_coroutine);
+	}
+
+	this->m_waiters.erase(it);
+
+	// the socket may already be closed, in which case the event loop has forgotten it anyway.
+	try { this->m_loop.Remove(socket); }
+	catch (const SocketException&) { }
+	catch (const std::invalid_argument&) { }
+
+}
+
+std::int32_t IoContext::RunOnce(const std::int32_t timeout) {
+
+	SocketEvent events[MAX_EVENTS_PER_RUN];
+	// coroutines that are already ready to be resumed don't wait for socket events.
+	const std::int32_t count = this->m_loop.Wait(events, (this->m_ready.empty() ? timeout : 0), this->m_timers);
+
+	// collect the coroutines to resume first, since resuming them can change the waiters.
+	std::vector<std::coroutine_handle<>> ready = std::move(this->m_ready);
+	this->m_ready.clear();
+	ready.reserve(ready.size() + count);
+
+	for (std::int32_t i = 0; i < count; ++i) {
+
+		auto it = this->m_waiters.find(static_cast<NativeSocket_t>(events[i].UserData));
+		if (it == this->m_waiters.end()) continue;
+
+		Waiters& waiters = it->second;
+		const bool failed = static_cast<bool>(events[i].Events & (PollEvents::ERROR | PollEvents::HANGUP));
+
+		if (waiters.Reader && (failed || static_cast<bool>(events[i].Events & PollEvents::READ)))
+			ready.push_back(std::exchange(waiters.Reader, nullptr)->m_coroutine);
+
+		if (waiters.Writer && (failed || static_cast<bool>(events[i].Events & PollEvents::WRITE)))
+			ready.push_back(std::exchange(waiters.Writer, nullptr)->m_coroutine);
+
+		// sockets without waiters are removed from the event loop, so closing them leaves nothing behind.
+		if (!waiters.Reader && !waiters.Writer) {
+			this->m_loop.Remove(*waiters.Target);
+			this->m_waiters.erase(it);
+		}
+		else this->m_loop.Modify(*waiters.Target, (waiters.Reader ? PollEvents::READ : PollEvents::WRITE), it->first);
+
+	}
+
+	for (const std::coroutine_handle<> coroutine : ready)
+		coroutine.resume();
+
+	return static_cast<std::int32_t>(ready.size());
+}
+
+void IoContext::Run() {
+
+	this->m_stopped = false;
+	while (!this->m_stopped && (!this->m_waiters.empty() || (this->m_timers.GetTimerCount() > 0) || !this->m_ready.empty()))
+		this->RunOnce(-1);
+
+}
+
+void IoContext::Stop() {
+	this->m_stopped = true;
+}
\ No newline at end of file
@@ -0,0 +1,550 @@
+#include <Vnetworking/Sockets/IoRing.h>
+
+#ifdef NE_PLATFORM_LINUX
+
+#include <Vnetworking/Sockets/SocketException.h>
+#include "Native.h"
+
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <signal.h>
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <exception>
+#include <stdexcept>
+
+using namespace Vnetworking::Sockets;
+using namespace Vnetworking::Sockets::Private;
+
+constexpr std::string_view ERR_BAD_SOCKET = "Invalid socket.";
+constexpr std::string_view ERR_BAD_ISOCKETADDRESS_IMPL = "Invalid ISocketAddress implementation.";
+constexpr std::string_view ERR_RING_CLOSED = "The IoRing has been moved from.";
+constexpr std::string_view ERR_SUBMISSION_QUEUE_FULL = "The submission queue is full.";
+constexpr std::string_view ERR_BUFFER_TOO_LARGE = "The buffer is larger than 4 GiB.";
+constexpr std::string_view ERR_BAD_BUFFER_COUNT = "'bufferCount' must be a power of two between 1 and 32768.";
+constexpr std::string_view ERR_BAD_BUFFER_SIZE = "'bufferSize' must be greater than zero.";
+constexpr std::string_view ERR_BUFFER_GROUP_EXISTS = "The buffer group is already registered.";
+constexpr std::string_view ERR_BAD_BUFFER_GROUP = "The buffer group is not registered.";
+constexpr std::string_view ERR_BAD_BUFFER_ID = "Invalid buffer id.";
+
+constexpr std::uint32_t DEFAULT_ENTRIES = 256;
+
+struct BufferGroup {
+	struct io_uring_buf_ring* Ring;
+	struct io_uring_buf* Buffers;
+	std::size_t RingSize;
+	std::uint32_t BufferCount;
+	std::uint32_t BufferSize;
+	std::vector<std::uint8_t> Storage;
+};
+
+struct Vnetworking::Sockets::NativeIoRing {
+
+	int Ring;
+	struct io_uring_params Params;
+
+	void* SqRing;
+	std::size_t SqRingSize;
+	void* CqRing;
+	std::size_t CqRingSize;
+	struct io_uring_sqe* Sqes;
+	std::size_t SqesSize;
+
+	std::uint32_t* SqHead;
+	std::uint32_t* SqTail;
+	std::uint32_t SqMask;
+	std::uint32_t* CqHead;
+	std::uint32_t* CqTail;
+	std::uint32_t CqMask;
+	struct io_uring_cqe* Cqes;
+
+	// sqes are filled in ring order, so SqeTail - SqeSubmitted entries are queued but not yet handed to the kernel.
+	std::uint32_t SqeTail;
+	std::uint32_t SqeSubmitted;
+
+	std::unordered_map<std::uint16_t, BufferGroup> BufferGroups;
+
+	// IORING_OP_CONNECT reads the address asynchronously, so it's kept alive until the completion is reaped.
+	std::unordered_map<std::uint64_t, struct sockaddr_storage> ConnectAddresses;
+
+};
+
+static inline int IoUringSetup(const std::uint32_t entries, struct io_uring_params* params) noexcept {
+	return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static inline int IoUringEnter(const int ring, const std::uint32_t toSubmit, const std::uint32_t minComplete, const std::uint32_t flags) noexcept {
+	return static_cast<int>(syscall(__NR_io_uring_enter, ring, toSubmit, minComplete, flags, nullptr, (_NSIG / 8)));
+}
+
+static inline int IoUringRegister(const int ring, const std::uint32_t opcode, void* arg, const std::uint32_t nrArgs) noexcept {
+	return static_cast<int>(syscall(__NR_io_uring_register, ring, opcode, arg, nrArgs));
+}
+
+template <typename T>
+static inline T LoadAcquire(T* ptr) noexcept {
+	return std::atomic_ref<T>(*ptr).load(std::memory_order_acquire);
+}
+
+template <typename T>
+static inline void StoreRelease(T* ptr, const T value) noexcept {
+	std::atomic_ref<T>(*ptr).store(value, std::memory_order_release);
+}
+
+static void DestroyRing(NativeIoRing* ring) noexcept {
+
+	if (ring == nullptr) return;
+
+	for (auto& [id, group] : ring->BufferGroups) {
+		struct io_uring_buf_reg reg = { };
+		reg.bgid = id;
+		IoUringRegister(ring->Ring, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+		munmap(group.Ring, group.RingSize);
+	}
+
+	if (ring->Sqes != nullptr) munmap(ring->Sqes, ring->SqesSize);
+	if ((ring->CqRing != nullptr) && (ring->CqRing != ring->SqRing)) munmap(ring->CqRing, ring->CqRingSize);
+	if (ring->SqRing != nullptr) munmap(ring->SqRing, ring->SqRingSize);
+	if (ring->Ring != -1) close(ring->Ring);
+
+	delete ring;
+
+}
+
+static void* MapRing(const int ring, const std::size_t size, const std::uint64_t offset) {
+
+	void* ptr = mmap(nullptr, size, (PROT_READ | PROT_WRITE), (MAP_SHARED | MAP_POPULATE), ring, static_cast<off_t>(offset));
+	if (ptr == MAP_FAILED)
+		throw SocketException(GetLastSocketError());
+
+	return ptr;
+}
+
+static NativeIoRing* CreateRing(const std::uint32_t entries) {
+
+	NativeIoRing* ring = new NativeIoRing { };
+	ring->Ring = -1;
+
+	try {
+
+		ring->Ring = IoUringSetup(entries, &ring->Params);
+		if (ring->Ring == -1)
+			throw SocketException(GetLastSocketError());
+
+		const struct io_uring_params& p = ring->Params;
+
+		ring->SqRingSize = (p.sq_off.array + (p.sq_entries * sizeof(std::uint32_t)));
+		ring->CqRingSize = (p.cq_off.cqes + (p.cq_entries * sizeof(struct io_uring_cqe)));
+		ring->SqesSize = (p.sq_entries * sizeof(struct io_uring_sqe));
+
+		if (p.features & IORING_FEAT_SINGLE_MMAP) {
+			ring->SqRingSize = ring->CqRingSize = std::max(ring->SqRingSize, ring->CqRingSize);
+			ring->SqRing = MapRing(ring->Ring, ring->SqRingSize, IORING_OFF_SQ_RING);
+			ring->CqRing = ring->SqRing;
+		}
+		else {
+			ring->SqRing = MapRing(ring->Ring, ring->SqRingSize, IORING_OFF_SQ_RING);
+			ring->CqRing = MapRing(ring->Ring, ring->CqRingSize, IORING_OFF_CQ_RING);
+		}
+
+		ring->Sqes = reinterpret_cast<struct io_uring_sqe*>(MapRing(ring->Ring, ring->SqesSize, IORING_OFF_SQES));
+
+		std::uint8_t* sq = reinterpret_cast<std::uint8_t*>(ring->SqRing);
+		std::uint8_t* cq = reinterpret_cast<std::uint8_t*>(ring->CqRing);
+
+		ring->SqHead = reinterpret_cast<std::uint32_t*>(sq + p.sq_off.head);
+		ring->SqTail = reinterpret_cast<std::uint32_t*>(sq + p.sq_off.tail);
+		ring->SqMask = *reinterpret_cast<std::uint32_t*>(sq + p.sq_off.ring_mask);
+		ring->CqHead = reinterpret_cast<std::uint32_t*>(cq + p.cq_off.head);
+		ring->CqTail = reinterpret_cast<std::uint32_t*>(cq + p.cq_off.tail);
+		ring->CqMask = *reinterpret_cast<std::uint32_t*>(cq + p.cq_off.ring_mask);
+		ring->Cqes = reinterpret_cast<struct io_uring_cqe*>(cq + p.cq_off.cqes);
+
+		// sqes are always used in ring order, so the indirection array is an identity mapping.
+		std::uint32_t* array = reinterpret_cast<std::uint32_t*>(sq + p.sq_off.array);
+		for (std::uint32_t i = 0; i < p.sq_entries; ++i)
+			array[i] = i;
+
+		ring->SqeTail = ring->SqeSubmitted = *ring->SqTail;
+
+	}
+	catch (...) {
+		DestroyRing(ring);
+		throw;
+	}
+
+	return ring;
+}
+
+static inline NativeIoRing* CheckRing(NativeIoRing* ring) {
+
+	if (ring == nullptr)
+		throw std::logic_error(ERR_RING_CLOSED.data());
+
+	return ring;
+}
+
+static inline int CheckSocket(const Socket& socket) {
+
+	if (socket.GetNativeSocketHandle() == INVALID_SOCKET_HANDLE)
+		throw std::invalid_argument(ERR_BAD_SOCKET.data());
+
+	return ToNativeHandle(socket.GetNativeSocketHandle());
+}
+
+IoRing::IoRing() : IoRing(DEFAULT_ENTRIES) { }
+
+IoRing::IoRing(const std::uint32_t entries) : m_ring(nullptr) {
+	this->m_ring = CreateRing(entries);
+}
+
+IoRing::IoRing(IoRing&& ring) noexcept : m_ring(nullptr) {
+	this->operator= (std::move(ring));
+}
+
+IoRing::~IoRing() {
+	DestroyRing(this->m_ring);
+	this->m_ring = nullptr;
+}
+
+IoRing& IoRing::operator= (IoRing&& ring) noexcept {
+
+	if (this->m_ring != ring.m_ring) {
+		DestroyRing(this->m_ring);
+		this->m_ring = ring.m_ring;
+		ring.m_ring = nullptr;
+	}
+
+	return static_cast<IoRing&>(*this);
+}
+
+std::int32_t IoRing::GetNativeHandle() const {
+	return ((this->m_ring != nullptr) ? this->m_ring->Ring : -1);
+}
+
+// returns a zeroed sqe, submitting the already queued operations first if the submission queue is full.
+static struct io_uring_sqe* GetSqe(IoRing& ioRing, NativeIoRing* ring) {
+
+	if ((ring->SqeTail - LoadAcquire(ring->SqHead)) >= ring->Params.sq_entries) {
+		ioRing.Submit();
+		if ((ring->SqeTail - LoadAcquire(ring->SqHead)) >= ring->Params.sq_entries)
+			throw SocketException(EBUSY, ERR_SUBMISSION_QUEUE_FULL.data());
+	}
+
+	struct io_uring_sqe* sqe = &ring->Sqes[ring->SqeTail & ring->SqMask];
+	std::memset(sqe, 0, sizeof(struct io_uring_sqe));
+	++ring->SqeTail;
+
+	return sqe;
+}
+
+void IoRing::Send(const Socket& socket, const std::span<const std::uint8_t>& data, const SocketFlags flags, const std::uint64_t userData) {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+	const int fd = CheckSocket(socket);
+
+	if (data.size() > UINT32_MAX)
+		throw std::out_of_range(ERR_BUFFER_TOO_LARGE.data());
+
+	struct io_uring_sqe* sqe = GetSqe(*this, ring);
+	sqe->opcode = IORING_OP_SEND;
+	sqe->fd = fd;
+	sqe->addr = reinterpret_cast<std::uint64_t>(data.data());
+	sqe->len = static_cast<std::uint32_t>(data.size());
+	sqe->msg_flags = static_cast<std::uint32_t>(CreateSendFlags(flags));
+	sqe->user_data = userData;
+
+}
+
+void IoRing::Receive(const Socket& socket, const std::span<std::uint8_t>& data, const SocketFlags flags, const std::uint64_t userData) {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+	const int fd = CheckSocket(socket);
+
+	if (data.size() > UINT32_MAX)
+		throw std::out_of_range(ERR_BUFFER_TOO_LARGE.data());
+
+	struct io_uring_sqe* sqe = GetSqe(*this, ring);
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = fd;
+	sqe->addr = reinterpret_cast<std::uint64_t>(data.data());
+	sqe->len = static_cast<std::uint32_t>(data.size());
+	sqe->msg_flags = static_cast<std::uint32_t>(CreateFlags(flags));
+	sqe->user_data = userData;
+
+}
+
+void IoRing::ReceiveMultishot(const Socket& socket, const std::uint16_t bufferGroup, const std::uint64_t userData) {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+	const int fd = CheckSocket(socket);
+
+	if (!ring->BufferGroups.contains(bufferGroup))
+		throw std::invalid_argument(ERR_BAD_BUFFER_GROUP.data());
+
+	struct io_uring_sqe* sqe = GetSqe(*this, ring);
+	sqe->opcode = IORING_OP_RECV;
+	sqe->fd = fd;
+	sqe->ioprio = IORING_RECV_MULTISHOT;
+	sqe->flags = IOSQE_BUFFER_SELECT;
+	sqe->buf_group = bufferGroup;
+	sqe->user_data = userData;
+
+}
+
+void IoRing::Accept(const Socket& socket, const std::uint64_t userData) {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+	const int fd = CheckSocket(socket);
+
+	struct io_uring_sqe* sqe = GetSqe(*this, ring);
+	sqe->opcode = IORING_OP_ACCEPT;
+	sqe->fd = fd;
+	sqe->accept_flags = SOCK_CLOEXEC;
+	sqe->user_data = userData;
+
+}
+
+void IoRing::AcceptMultishot(const Socket& socket, const std::uint64_t userData) {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+	const int fd = CheckSocket(socket);
+
+	struct io_uring_sqe* sqe = GetSqe(*this, ring);
+	sqe->opcode = IORING_OP_ACCEPT;
+	sqe->fd = fd;
+	sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+	sqe->accept_flags = SOCK_CLOEXEC;
+	sqe->user_data = userData;
+
+}
+
+void IoRing::Connect(const Socket& socket, const ISocketAddress& sockaddr, const std::uint64_t userData) {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+	const int fd = CheckSocket(socket);
+
+	const std::int32_t addressLen = sockaddr.GetNativeSocketAddressLength();
+	if ((addressLen <= 0) || (static_cast<std::size_t>(addressLen) > sizeof(struct sockaddr_storage)))
+		throw std::invalid_argument(ERR_BAD_ISOCKETADDRESS_IMPL.data());
+
+	struct sockaddr_storage& address = ring->ConnectAddresses[userData];
+	std::memcpy(&address, sockaddr.GetNativeSocketAddress(), static_cast<std::size_t>(addressLen));
+
+	struct io_uring_sqe* sqe = nullptr;
+	try { sqe = GetSqe(*this, ring); }
+	catch (...) {
+		ring->ConnectAddresses.erase(userData);
+		throw;
+	}
+
+	sqe->opcode = IORING_OP_CONNECT;
+	sqe->fd = fd;
+	sqe->addr = reinterpret_cast<std::uint64_t>(&address);
+	sqe->off = static_cast<std::uint64_t>(addressLen);
+	sqe->user_data = userData;
+
+}
+
+void IoRing::Cancel(const std::uint64_t target, const std::uint64_t userData) {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+
+	struct io_uring_sqe* sqe = GetSqe(*this, ring);
+	sqe->opcode = IORING_OP_ASYNC_CANCEL;
+	sqe->fd = -1;
+	sqe->addr = target;
+	sqe->user_data = userData;
+
+}
+
+void IoRing::RegisterBufferGroup(const std::uint16_t bufferGroup, const std::uint32_t bufferCount, const std::uint32_t bufferSize) {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+
+	if ((bufferCount == 0) || (bufferCount > 32768) || ((bufferCount & (bufferCount - 1)) != 0))
+		throw std::invalid_argument(ERR_BAD_BUFFER_COUNT.data());
+
+	if (bufferSize == 0)
+		throw std::invalid_argument(ERR_BAD_BUFFER_SIZE.data());
+
+	if (ring->BufferGroups.contains(bufferGroup))
+		throw std::invalid_argument(ERR_BUFFER_GROUP_EXISTS.data());
+
+	BufferGroup group = { };
+	group.BufferCount = bufferCount;
+	group.BufferSize = bufferSize;
+	group.RingSize = (bufferCount * sizeof(struct io_uring_buf));
+	group.Storage.resize(static_cast<std::size_t>(bufferCount) * bufferSize);
+
+	// the buffer ring must be page aligned, anonymous mmap takes care of that.
+	void* mem = mmap(nullptr, group.RingSize, (PROT_READ | PROT_WRITE), (MAP_PRIVATE | MAP_ANONYMOUS), -1, 0);
+	if (mem == MAP_FAILED)
+		throw SocketException(GetLastSocketError());
+
+	// the kernel header declares io_uring_buf_ring::bufs with __DECLARE_FLEX_ARRAY, whose empty struct
+	// has a size of 1 in C++ and shifts the array. the buffers start at the beginning of the ring, so index from there.
+	group.Ring = reinterpret_cast<struct io_uring_buf_ring*>(mem);
+	group.Buffers = reinterpret_cast<struct io_uring_buf*>(mem);
+	std::memset(mem, 0, group.RingSize);
+
+	struct io_uring_buf_reg reg = { };
+	reg.ring_addr = reinterpret_cast<std::uint64_t>(mem);
+	reg.ring_entries = bufferCount;
+	reg.bgid = bufferGroup;
+
+	if (IoUringRegister(ring->Ring, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+		const std::int32_t err = GetLastSocketError();
+		munmap(mem, group.RingSize);
+		throw SocketException(err);
+	}
+
+	// hand all buffers to the kernel:
+	for (std::uint32_t i = 0; i < bufferCount; ++i) {
+		struct io_uring_buf* buf = &group.Buffers[i];
+		buf->addr = reinterpret_cast<std::uint64_t>(group.Storage.data() + (static_cast<std::size_t>(i) * bufferSize));
+		buf->len = bufferSize;
+		buf->bid = static_cast<std::uint16_t>(i);
+	}
+
+	StoreRelease(&group.Ring->tail, static_cast<std::uint16_t>(bufferCount));
+
+	ring->BufferGroups.emplace(bufferGroup, std::move(group));
+
+}
+
+void IoRing::UnregisterBufferGroup(const std::uint16_t bufferGroup) {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+
+	if (!ring->BufferGroups.contains(bufferGroup))
+		throw std::invalid_argument(ERR_BAD_BUFFER_GROUP.data());
+
+	struct io_uring_buf_reg reg = { };
+	reg.bgid = bufferGroup;
+
+	if (IoUringRegister(ring->Ring, IORING_UNREGISTER_PBUF_RING, &reg, 1) < 0)
+		throw SocketException(GetLastSocketError());
+
+	BufferGroup& group = ring->BufferGroups.at(bufferGroup);
+	munmap(group.Ring, group.RingSize);
+	ring->BufferGroups.erase(bufferGroup);
+
+}
+
+std::span<std::uint8_t> IoRing::GetBuffer(const std::uint16_t bufferGroup, const std::int32_t bufferId) const {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+
+	if (!ring->BufferGroups.contains(bufferGroup))
+		throw std::invalid_argument(ERR_BAD_BUFFER_GROUP.data());
+
+	BufferGroup& group = ring->BufferGroups.at(bufferGroup);
+	if ((bufferId < 0) || (static_cast<std::uint32_t>(bufferId) >= group.BufferCount))
+		throw std::out_of_range(ERR_BAD_BUFFER_ID.data());
+
+	return { (group.Storage.data() + (static_cast<std::size_t>(bufferId) * group.BufferSize)), group.BufferSize };
+}
+
+void IoRing::ReleaseBuffer(const std::uint16_t bufferGroup, const std::int32_t bufferId) {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+
+	if (!ring->BufferGroups.contains(bufferGroup))
+		throw std::invalid_argument(ERR_BAD_BUFFER_GROUP.data());
+
+	BufferGroup& group = ring->BufferGroups.at(bufferGroup);
+	if ((bufferId < 0) || (static_cast<std::uint32_t>(bufferId) >= group.BufferCount))
+		throw std::out_of_range(ERR_BAD_BUFFER_ID.data());
+
+	// only the application writes the tail, so a plain read is fine here.
+	const std::uint16_t tail = group.Ring->tail;
+
+	struct io_uring_buf* buf = &group.Buffers[tail & (group.BufferCount - 1)];
+	buf->addr = reinterpret_cast<std::uint64_t>(group.Storage.data() + (static_cast<std::size_t>(bufferId) * group.BufferSize));
+	buf->len = group.BufferSize;
+	buf->bid = static_cast<std::uint16_t>(bufferId);
+
+	StoreRelease(&group.Ring->tail, static_cast<std::uint16_t>(tail + 1));
+
+}
+
+static std::int32_t Enter(NativeIoRing* ring, const std::uint32_t minCompletions) {
+
+	StoreRelease(ring->SqTail, ring->SqeTail);
+
+	const std::uint32_t toSubmit = (ring->SqeTail - ring->SqeSubmitted);
+	const std::uint32_t flags = ((minCompletions > 0) ? IORING_ENTER_GETEVENTS : 0);
+
+	if ((toSubmit == 0) && (minCompletions == 0))
+		return 0;
+
+	int submitted = 0;
+	do submitted = IoUringEnter(ring->Ring, toSubmit, minCompletions, flags);
+	while ((submitted == -1) && (errno == EINTR));
+
+	if (submitted == -1)
+		throw SocketException(GetLastSocketError());
+
+	ring->SqeSubmitted += static_cast<std::uint32_t>(submitted);
+
+	return static_cast<std::int32_t>(submitted);
+}
+
+std::int32_t IoRing::Submit() {
+	return Enter(CheckRing(this->m_ring), 0);
+}
+
+std::int32_t IoRing::SubmitAndWait(const std::uint32_t minCompletions) {
+	return Enter(CheckRing(this->m_ring), minCompletions);
+}
+
+std::int32_t IoRing::GetCompletions(const std::span<IoCompletion>& completions) {
+
+	NativeIoRing* ring = CheckRing(this->m_ring);
+
+	std::uint32_t head = *ring->CqHead;
+	const std::uint32_t tail = LoadAcquire(ring->CqTail);
+
+	std::int32_t count = 0;
+	while ((head != tail) && (static_cast<std::size_t>(count) < completions.size())) {
+
+		const struct io_uring_cqe& cqe = ring->Cqes[head & ring->CqMask];
+		IoCompletion& completion = completions[count++];
+
+		completion.UserData = cqe.user_data;
+		completion.Result = cqe.res;
+		completion.More = ((cqe.flags & IORING_CQE_F_MORE) != 0);
+		completion.BufferId = ((cqe.flags & IORING_CQE_F_BUFFER) ? static_cast<std::int32_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT) : NO_BUFFER_ID);
+
+		if (!ring->ConnectAddresses.empty())
+			ring->ConnectAddresses.erase(cqe.user_data);
+
+		++head;
+
+	}
+
+	StoreRelease(ring->CqHead, head);
+
+	return count;
+}
+
+Socket IoRing::GetAcceptedSocket(const Socket& listener, const IoCompletion& completion) const {
+
+	if (completion.Result < 0)
+		throw SocketException(-completion.Result);
+
+	return Socket(
+		static_cast<NativeSocket_t>(completion.Result),
+		listener.GetAddressFamily(),
+		listener.GetSocketType(),
+		listener.GetProtocolType()
+	);
+}
+
+#endif
\ No newline at end of file
@@ -1,14 +1,34 @@
 #include <Vnetworking/Sockets/IpSocketAddress.h>
+#include "Native.h"
+
+#include <cstring>
+#include <exception>
+#include <stdexcept>
 
 using namespace Vnetworking;
 using namespace Vnetworking::Sockets;
 
-IpSocketAddress::IpSocketAddress() : m_af(AddressFamily::IPV4), m_ipAddress({ 0, 0, 0, 0 }), m_port(0) { }
+static_assert(sizeof(struct sockaddr_in6) <= IP_NATIVE_SOCKADDR_SIZE, "IP_NATIVE_SOCKADDR_SIZE is too small.");
 
-IpSocketAddress::IpSocketAddress(const IpAddress& ipAddress, const Port port) 
+constexpr std::string_view ERR_BAD_NATIVE_SOCKADDR = "The native socket address is not a valid IPv4 or IPv6 address.";
+
+IpSocketAddress::IpSocketAddress() : m_af(AddressFamily::IPV4), m_ipAddress(0, 0, 0, 0), m_port(0), m_scopeId(0) { 
+	this->UpdateNativeSocketAddress();
+}
+
+// the scope id (the interface index) is only used by IPv6 addresses, and is required for link-local ones (fe80::/10).
+IpSocketAddress::IpSocketAddress(const IpAddress& ipAddress, const Port port, const std::uint32_t scopeId) 
 	: m_af( ipAddress.IsVersion6() ? AddressFamily::IPV6 : AddressFamily::IPV4 ), 
 	m_ipAddress(ipAddress), 
-	m_port(port) { }
+	m_port(port), 
+	m_scopeId(scopeId) { 
+	
+	this->UpdateNativeSocketAddress();
+
+}
+
+IpSocketAddress::IpSocketAddress(const IpAddress& ipAddress, const Port port) 
+	: IpSocketAddress(ipAddress, port, 0) { }
 
 IpSocketAddress::IpSocketAddress(const IpSocketAddress& sockaddr) {
 	this->operator= (sockaddr);
@@ -24,6 +44,9 @@ IpSocketAddress& IpSocketAddress::operator= (const IpSocketAddress& sockaddr) {
 	this->m_af = sockaddr.m_af;
 	this->m_ipAddress = sockaddr.m_ipAddress;
 	this->m_port = sockaddr.m_port;
+	this->m_scopeId = sockaddr.m_scopeId;
+	this->m_sockaddr = sockaddr.m_sockaddr;
+	this->m_sockaddrLen = sockaddr.m_sockaddrLen;
 	return static_cast<IpSocketAddress&>(*this);
 }
 
@@ -31,11 +54,14 @@ IpSocketAddress& IpSocketAddress::operator= (IpSocketAddress&& sockaddr) noexcep
 	this->m_af = std::move(sockaddr.m_af);
 	this->m_ipAddress = std::move(sockaddr.m_ipAddress);
 	this->m_port = std::move(sockaddr.m_port); 
+	this->m_scopeId = sockaddr.m_scopeId;
+	this->m_sockaddr = std::move(sockaddr.m_sockaddr);
+	this->m_sockaddrLen = sockaddr.m_sockaddrLen;
 	return static_cast<IpSocketAddress&>(*this);
 }
 
 bool IpSocketAddress::operator== (const IpSocketAddress& sockaddr) const {
-	return ((this->m_af == sockaddr.m_af) && (this->m_ipAddress == sockaddr.m_ipAddress) && (this->m_port == sockaddr.m_port));
+	return ((this->m_af == sockaddr.m_af) && (this->m_ipAddress == sockaddr.m_ipAddress) && (this->m_port == sockaddr.m_port) && (this->m_scopeId == sockaddr.m_scopeId));
 }
 
 AddressFamily IpSocketAddress::GetAddressFamily() const {
@@ -50,11 +76,86 @@ Port IpSocketAddress::GetPort() const {
 	return this->m_port;
 }
 
+std::uint32_t IpSocketAddress::GetScopeId() const {
+	return this->m_scopeId;
+}
+
 void IpSocketAddress::SetIpAddress(const IpAddress& ipAddress) {
 	this->m_ipAddress = ipAddress;
 	this->m_af = (ipAddress.IsVersion6() ? AddressFamily::IPV6 : AddressFamily::IPV4);
+	this->UpdateNativeSocketAddress();
 }
 
 void IpSocketAddress::SetPort(const Port port) {
 	this->m_port = port;
+	this->UpdateNativeSocketAddress();
+}
+
+void IpSocketAddress::SetScopeId(const std::uint32_t scopeId) {
+	this->m_scopeId = scopeId;
+	this->UpdateNativeSocketAddress();
+}
+
+const void* IpSocketAddress::GetNativeSocketAddress() const {
+	return this->m_sockaddr.data();
+}
+
+std::int32_t IpSocketAddress::GetNativeSocketAddressLength() const {
+	return this->m_sockaddrLen;
+}
+
+void IpSocketAddress::SetNativeSocketAddress(const void* sockaddr, const std::int32_t length) {
+
+	const struct sockaddr* source = reinterpret_cast<const struct sockaddr*>(sockaddr);
+
+	if ((source == nullptr) || (length < static_cast<std::int32_t>(sizeof(struct sockaddr_in))))
+		throw std::invalid_argument(ERR_BAD_NATIVE_SOCKADDR.data());
+
+	if (source->sa_family == AF_INET) {
+		const struct sockaddr_in* in4 = reinterpret_cast<const struct sockaddr_in*>(source);
+		std::array<std::uint8_t, 4> bytes;
+		std::memcpy(bytes.data(), &in4->sin_addr.s_addr, bytes.size());
+		this->m_af = AddressFamily::IPV4;
+		this->m_ipAddress = IpAddress(bytes);
+		this->m_port = ntohs(in4->sin_port);
+		this->m_scopeId = 0;
+	}
+	else if ((source->sa_family == AF_INET6) && (length >= static_cast<std::int32_t>(sizeof(struct sockaddr_in6)))) {
+		const struct sockaddr_in6* in6 = reinterpret_cast<const struct sockaddr_in6*>(source);
+		std::array<std::uint8_t, 16> bytes;
+		std::memcpy(bytes.data(), in6->sin6_addr.s6_addr, bytes.size());
+		this->m_af = AddressFamily::IPV6;
+		this->m_ipAddress = IpAddress(bytes);
+		this->m_port = ntohs(in6->sin6_port);
+		this->m_scopeId = in6->sin6_scope_id;
+	}
+	else throw std::invalid_argument(ERR_BAD_NATIVE_SOCKADDR.data());
+
+	this->UpdateNativeSocketAddress();
+
+}
+
+// builds the native sockaddr_in/sockaddr_in6 once, so sockets don't have to
+// format the address and go through getaddrinfo on every Bind, Connect and SendTo.
+void IpSocketAddress::UpdateNativeSocketAddress() {
+
+	this->m_sockaddr.fill(0);
+	const auto& bytes = this->m_ipAddress.GetAddressBytes();
+
+	if (this->m_af == AddressFamily::IPV6) {
+		struct sockaddr_in6* sockaddr = reinterpret_cast<struct sockaddr_in6*>(this->m_sockaddr.data());
+		sockaddr->sin6_family = AF_INET6;
+		sockaddr->sin6_port = htons(this->m_port);
+		std::memcpy(sockaddr->sin6_addr.s6_addr, bytes.data(), 16);
+		sockaddr->sin6_scope_id = this->m_scopeId;
+		this->m_sockaddrLen = sizeof(struct sockaddr_in6);
+	}
+	else {
+		struct sockaddr_in* sockaddr = reinterpret_cast<struct sockaddr_in*>(this->m_sockaddr.data());
+		sockaddr->sin_family = AF_INET;
+		sockaddr->sin_port = htons(this->m_port);
+		std::memcpy(&sockaddr->sin_addr.s_addr, bytes.data(), 4);
+		this->m_sockaddrLen = sizeof(struct sockaddr_in);
+	}
+
 }
\ No newline at end of file
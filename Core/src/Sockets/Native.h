@@ -0,0 +1,270 @@
+#pragma once
+
+#include <Vnetworking/Platform.h>
+#include <Vnetworking/Sockets/Socket.h>
+#include <Vnetworking/Sockets/SocketException.h>
+#include <Vnetworking/Sockets/SocketFlags.h>
+
+#include <cstdint>
+#include <thread>
+#include <unordered_map>
+
+#ifdef NE_PLATFORM_WINDOWS
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#include <iphlpapi.h>
+#include <MSWSock.h>
+#include <mstcpip.h>
+#include <afunix.h>
+
+#pragma comment (lib, "WS2_32.lib")
+#pragma comment (lib, "Mswsock.lib")
+
+#ifdef ERROR
+#undef ERROR
+#endif
+
+#else
+
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <sys/stat.h>
+#include <sys/sendfile.h>
+#include <sys/un.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netinet/udp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <unistd.h>
+#include <errno.h>
+
+#define SOCKET_ERROR (-1)
+#define INVALID_SOCKET (-1)
+
+#define SD_RECEIVE SHUT_RD
+#define SD_SEND SHUT_WR
+#define SD_BOTH SHUT_RDWR
+
+// UDP segmentation offload (GSO/GRO) options; older libc headers don't define them.
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
+
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+
+#ifndef SO_INCOMING_NAPI_ID
+#define SO_INCOMING_NAPI_ID 56
+#endif
+
+#endif
+
+namespace Vnetworking::Sockets::Private {
+
+#ifdef NE_PLATFORM_WINDOWS
+	typedef SOCKET NativeHandle_t;
+	typedef WSAPOLLFD NativePollFd_t;
+	typedef WSABUF NativeBuffer_t;
+#else
+	typedef int NativeHandle_t;
+	typedef struct pollfd NativePollFd_t;
+	typedef struct iovec NativeBuffer_t;
+
+	// the kernel's struct tcp_info (linux/tcp.h). glibc's netinet/tcp.h only declares the fields up to
+	// tcpi_total_retrans and the two headers can't be included together. the kernel copies as much of
+	// the structure as both sides know about, so newer fields simply stay zeroed on older kernels.
+	typedef struct {
+		std::uint8_t State;
+		std::uint8_t CaState;
+		std::uint8_t Retransmits;
+		std::uint8_t Probes;
+		std::uint8_t Backoff;
+		std::uint8_t Options;
+		std::uint8_t WindowScale;
+		std::uint8_t Flags;
+		std::uint32_t Rto;
+		std::uint32_t Ato;
+		std::uint32_t SndMss;
+		std::uint32_t RcvMss;
+		std::uint32_t Unacked;
+		std::uint32_t Sacked;
+		std::uint32_t Lost;
+		std::uint32_t Retrans;
+		std::uint32_t Fackets;
+		std::uint32_t LastDataSent;
+		std::uint32_t LastAckSent;
+		std::uint32_t LastDataRecv;
+		std::uint32_t LastAckRecv;
+		std::uint32_t Pmtu;
+		std::uint32_t RcvSsthresh;
+		std::uint32_t Rtt;
+		std::uint32_t RttVar;
+		std::uint32_t SndSsthresh;
+		std::uint32_t SndCwnd;
+		std::uint32_t AdvMss;
+		std::uint32_t Reordering;
+		std::uint32_t RcvRtt;
+		std::uint32_t RcvSpace;
+		std::uint32_t TotalRetrans;
+		std::uint64_t PacingRate;
+		std::uint64_t MaxPacingRate;
+		std::uint64_t BytesAcked;
+		std::uint64_t BytesReceived;
+		std::uint32_t SegsOut;
+		std::uint32_t SegsIn;
+		std::uint32_t NotsentBytes;
+		std::uint32_t MinRtt;
+		std::uint32_t DataSegsIn;
+		std::uint32_t DataSegsOut;
+		std::uint64_t DeliveryRate;
+		std::uint64_t BusyTime;
+		std::uint64_t RwndLimited;
+		std::uint64_t SndbufLimited;
+		std::uint32_t Delivered;
+		std::uint32_t DeliveredCe;
+		std::uint64_t BytesSent;
+		std::uint64_t BytesRetrans;
+	} NativeTcpInfo;
+#endif
+
+	// converts Vnetworking's NativeSocket_t to the handle type the platform's socket functions take.
+	static inline NativeHandle_t ToNativeHandle(const NativeSocket_t socket) noexcept {
+		return static_cast<NativeHandle_t>(socket);
+	}
+
+	// returns the error code of the last failed socket function (WSAGetLastError on Windows, errno elsewhere)
+	static inline std::int32_t GetLastSocketError(void) noexcept {
+#ifdef NE_PLATFORM_WINDOWS
+		return static_cast<std::int32_t>(WSAGetLastError());
+#else
+		return static_cast<std::int32_t>(errno);
+#endif
+	}
+
+	// returns true if the error code means that a non-blocking operation would have blocked.
+	static inline bool IsWouldBlockError(const std::int32_t err) noexcept {
+#ifdef NE_PLATFORM_WINDOWS
+		return (err == WSAEWOULDBLOCK);
+#else
+		return ((err == EAGAIN) || (err == EWOULDBLOCK));
+#endif
+	}
+
+	// returns true if accept failed only because of the connection it tried to accept,
+	// e.g. the client reset it while it was still in the accept queue.
+	static inline bool IsConnectionAbortedError(const std::int32_t err) noexcept {
+#ifdef NE_PLATFORM_WINDOWS
+		return ((err == WSAECONNRESET) || (err == WSAECONNABORTED) || (err == WSAEINTR));
+#else
+		return ((err == ECONNABORTED) || (err == EPROTO) || (err == EPERM) || (err == EINTR));
+#endif
+	}
+
+	static inline int CloseNativeSocket(const NativeSocket_t socket) noexcept {
+#ifdef NE_PLATFORM_WINDOWS
+		return closesocket(ToNativeHandle(socket));
+#else
+		return close(ToNativeHandle(socket));
+#endif
+	}
+
+	static inline int PollNativeSockets(NativePollFd_t* fds, const std::uint32_t count, const std::int32_t timeout) noexcept {
+#ifdef NE_PLATFORM_WINDOWS
+		return WSAPoll(fds, static_cast<ULONG>(count), timeout);
+#else
+		return poll(fds, static_cast<nfds_t>(count), timeout);
+#endif
+	}
+
+	// fills a scatter/gather buffer descriptor (WSABUF on Windows, iovec elsewhere).
+	static inline void SetNativeBuffer(NativeBuffer_t& buffer, const void* data, const std::size_t size) noexcept {
+#ifdef NE_PLATFORM_WINDOWS
+		buffer.buf = static_cast<CHAR*>(const_cast<void*>(data));
+		buffer.len = static_cast<ULONG>(size);
+#else
+		buffer.iov_base = const_cast<void*>(data);
+		buffer.iov_len = size;
+#endif
+	}
+
+	// pins the calling thread to a CPU (wrapped around the number of CPUs).
+	static inline void PinCurrentThread(const std::uint32_t cpu) noexcept {
+
+		const std::uint32_t cpuCount = std::thread::hardware_concurrency();
+		if (cpuCount == 0) return;
+
+		const std::uint32_t target = (cpu % cpuCount);
+
+#ifdef NE_PLATFORM_WINDOWS
+		if (target < (sizeof(DWORD_PTR) * 8))
+			SetThreadAffinityMask(GetCurrentThread(), (static_cast<DWORD_PTR>(1) << target));
+#else
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		CPU_SET(target, &set);
+		pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#endif
+
+	}
+
+	static const std::unordered_map<SocketFlags, std::int32_t> s_socketFlags = { 
+
+		{ SocketFlags::NONE, 0 },
+		{ SocketFlags::OUT_OF_BAND, MSG_OOB },
+		{ SocketFlags::PEEK, MSG_PEEK },
+		{ SocketFlags::DONT_ROUTE, MSG_DONTROUTE },
+
+	};
+
+	static inline std::int32_t CreateFlags(const SocketFlags flags) noexcept {
+
+		std::int32_t nf = 0;
+		for (const auto& [key, val] : s_socketFlags) {
+			if (static_cast<bool>(flags & key)) nf |= val;
+		}
+
+		return nf;
+	}
+
+	// the flags for a send. on Linux, MSG_NOSIGNAL makes a send to a reset connection fail with EPIPE instead of raising SIGPIPE.
+	static inline std::int32_t CreateSendFlags(const SocketFlags flags) noexcept {
+#ifdef NE_PLATFORM_WINDOWS
+		return CreateFlags(flags);
+#else
+		return (CreateFlags(flags) | MSG_NOSIGNAL);
+#endif
+	}
+
+	// creates a SocketException for an error code returned by getaddrinfo.
+	// on Windows these are regular WSA error codes, elsewhere they are EAI_* codes and need gai_strerror.
+	static inline SocketException CreateAddrinfoException(const int res) {
+#ifdef NE_PLATFORM_WINDOWS
+		return SocketException(static_cast<std::int32_t>(res));
+#else
+		return SocketException(static_cast<std::int32_t>(res), gai_strerror(res));
+#endif
+	}
+
+}
@@ -0,0 +1,165 @@
+#include <Vnetworking/Sockets/RateLimiter.h>
+
+#include <cmath>
+#include <thread>
+#include <algorithm>
+
+using namespace Vnetworking::Sockets;
+
+// by default, a bucket holds 10 ms worth of tokens, but always enough for one full-sized Ethernet frame.
+constexpr std::uint64_t DEFAULT_BURSTS_PER_SECOND = 100;
+constexpr std::uint64_t MIN_DEFAULT_BYTE_BURST = 1500;
+constexpr std::uint64_t MIN_DEFAULT_PACKET_BURST = 1;
+
+// returns how long a bucket with the given tokens and rate takes to hold the tokens a request needs, in seconds.
+static double GetWaitSeconds(const double tokens, const std::uint64_t rate, const std::uint64_t burst, const std::uint64_t request) noexcept {
+
+	if ((rate == 0) || (request == 0)) return 0.0;
+
+	const double needed = static_cast<double>(std::min(request, burst));
+	if (tokens >= needed) return 0.0;
+
+	return ((needed - tokens) / static_cast<double>(rate));
+}
+
+RateLimiter::RateLimiter(const std::uint64_t bytesPerSecond, const std::uint64_t packetsPerSecond, const std::uint64_t byteBurst, const std::uint64_t packetBurst)
+	: m_bytesPerSecond(0), m_packetsPerSecond(0), m_byteBurst(0), m_packetBurst(0), m_byteTokens(0), m_packetTokens(0) {
+
+	this->m_lastRefill = std::chrono::steady_clock::now();
+	this->SetRate(bytesPerSecond, packetsPerSecond, byteBurst, packetBurst);
+
+	// the bucket starts full.
+	this->m_byteTokens = static_cast<double>(this->m_byteBurst);
+	this->m_packetTokens = static_cast<double>(this->m_packetBurst);
+
+}
+
+RateLimiter::RateLimiter(const std::uint64_t bytesPerSecond, const std::uint64_t packetsPerSecond)
+	: RateLimiter(
+		bytesPerSecond,
+		packetsPerSecond,
+		std::max((bytesPerSecond / DEFAULT_BURSTS_PER_SECOND), MIN_DEFAULT_BYTE_BURST),
+		std::max((packetsPerSecond / DEFAULT_BURSTS_PER_SECOND), MIN_DEFAULT_PACKET_BURST)
+	) { }
+
+RateLimiter::~RateLimiter() { }
+
+std::uint64_t RateLimiter::GetBytesPerSecond() const {
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->m_bytesPerSecond;
+}
+
+std::uint64_t RateLimiter::GetPacketsPerSecond() const {
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->m_packetsPerSecond;
+}
+
+std::uint64_t RateLimiter::GetByteBurst() const {
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->m_byteBurst;
+}
+
+std::uint64_t RateLimiter::GetPacketBurst() const {
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->m_packetBurst;
+}
+
+void RateLimiter::SetRate(const std::uint64_t bytesPerSecond, const std::uint64_t packetsPerSecond, const std::uint64_t byteBurst, const std::uint64_t packetBurst) {
+
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	// tokens gathered so far are accounted at the old rate.
+	this->Refill();
+
+	this->m_bytesPerSecond = bytesPerSecond;
+	this->m_packetsPerSecond = packetsPerSecond;
+	this->m_byteBurst = std::max<std::uint64_t>(byteBurst, 1);
+	this->m_packetBurst = std::max<std::uint64_t>(packetBurst, 1);
+
+	this->m_byteTokens = std::min(this->m_byteTokens, static_cast<double>(this->m_byteBurst));
+	this->m_packetTokens = std::min(this->m_packetTokens, static_cast<double>(this->m_packetBurst));
+
+}
+
+// takes the tokens for a send if the bucket holds enough of them, without waiting.
+bool RateLimiter::TryAcquire(const std::uint64_t bytes, const std::uint64_t packets) {
+
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	this->Refill();
+	if (this->GetDelayLocked(bytes, packets).count() > 0) return false;
+
+	if (this->m_bytesPerSecond > 0) this->m_byteTokens -= static_cast<double>(bytes);
+	if (this->m_packetsPerSecond > 0) this->m_packetTokens -= static_cast<double>(packets);
+
+	return true;
+}
+
+// waits until the bucket holds enough tokens for a send, and takes them.
+void RateLimiter::Acquire(const std::uint64_t bytes, const std::uint64_t packets) {
+
+	while (true) {
+
+		std::chrono::microseconds delay;
+
+		{
+			const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+			this->Refill();
+			delay = this->GetDelayLocked(bytes, packets);
+
+			if (delay.count() == 0) {
+				if (this->m_bytesPerSecond > 0) this->m_byteTokens -= static_cast<double>(bytes);
+				if (this->m_packetsPerSecond > 0) this->m_packetTokens -= static_cast<double>(packets);
+				return;
+			}
+		}
+
+		// other senders sharing the bucket may take the tokens first, so the delay is checked again after sleeping.
+		std::this_thread::sleep_for(delay);
+
+	}
+
+}
+
+// gives back tokens that were acquired for data that wasn't sent, e.g. when a send failed or sent only part of the data.
+void RateLimiter::Release(const std::uint64_t bytes, const std::uint64_t packets) {
+
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	if (this->m_bytesPerSecond > 0) this->m_byteTokens = std::min((this->m_byteTokens + static_cast<double>(bytes)), static_cast<double>(this->m_byteBurst));
+	if (this->m_packetsPerSecond > 0) this->m_packetTokens = std::min((this->m_packetTokens + static_cast<double>(packets)), static_cast<double>(this->m_packetBurst));
+
+}
+
+// returns how long a send has to wait for its tokens, e.g. for scheduling a timer on an event loop.
+std::chrono::microseconds RateLimiter::GetDelay(const std::uint64_t bytes, const std::uint64_t packets) const {
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->GetDelayLocked(bytes, packets);
+}
+
+void RateLimiter::Refill() {
+
+	const auto now = std::chrono::steady_clock::now();
+	const double elapsed = std::chrono::duration<double>(now - this->m_lastRefill).count();
+	this->m_lastRefill = now;
+
+	this->m_byteTokens = std::min((this->m_byteTokens + (elapsed * static_cast<double>(this->m_bytesPerSecond))), static_cast<double>(this->m_byteBurst));
+	this->m_packetTokens = std::min((this->m_packetTokens + (elapsed * static_cast<double>(this->m_packetsPerSecond))), static_cast<double>(this->m_packetBurst));
+
+}
+
+std::chrono::microseconds RateLimiter::GetDelayLocked(const std::uint64_t bytes, const std::uint64_t packets) const {
+
+	// the tokens gathered since the last refill are counted without storing them, so that this works on a const bucket.
+	const double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->m_lastRefill).count();
+	const double byteTokens = (this->m_byteTokens + (elapsed * static_cast<double>(this->m_bytesPerSecond)));
+	const double packetTokens = (this->m_packetTokens + (elapsed * static_cast<double>(this->m_packetsPerSecond)));
+
+	const double wait = std::max(
+		GetWaitSeconds(byteTokens, this->m_bytesPerSecond, this->m_byteBurst, bytes),
+		GetWaitSeconds(packetTokens, this->m_packetsPerSecond, this->m_packetBurst, packets)
+	);
+
+	return std::chrono::microseconds(static_cast<std::int64_t>(std::ceil(wait * 1e6)));
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include <Vnetworking/Sockets/ShardedListener.h>
+#include <Vnetworking/Sockets/SocketException.h>
+#include "Native.h"
+
+#ifndef NE_PLATFORM_WINDOWS
+#include <linux/filter.h>
+#endif
+
+#include <optional>
+#include <chrono>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using namespace Vnetworking::Sockets;
+using namespace Vnetworking::Sockets::Private;
+
+constexpr std::string_view ERR_BAD_SHARD_COUNT = "Cannot create a sharded listener with zero or less shards.";
+constexpr std::string_view ERR_SHARD_OUT_OF_RANGE = "'shard' is out of range.";
+constexpr std::string_view ERR_ALREADY_RUNNING = "The sharded listener is already running.";
+
+// how often (in milliseconds) workers check whether the listener has been stopped.
+constexpr std::int32_t STOP_POLL_INTERVAL = 100;
+
+// how long (in milliseconds) a worker waits before accepting again after a failed accept,
+// e.g. when the process ran out of file descriptors (the listener stays readable until then).
+constexpr std::int32_t ACCEPT_BACKOFF_INTERVAL = 100;
+
+// waits for connections to accept. a signal interrupting the wait counts as a timeout,
+// since poll is never restarted after a signal handler returns (not even with SA_RESTART).
+static bool WaitForConnections(const Socket& listener) {
+
+	try { return listener.Poll(PollEvents::READ, STOP_POLL_INTERVAL); }
+	catch (const SocketException& ex) {
+#ifdef NE_PLATFORM_WINDOWS
+		if (ex.GetErrorCode() == WSAEINTR) return false;
+#else
+		if (ex.GetErrorCode() == EINTR) return false;
+#endif
+		throw;
+	}
+
+}
+
+static Socket CreateListener(const IpSocketAddress& sockaddr, const bool reusePort) {
+
+	Socket socket(sockaddr.GetAddressFamily(), SocketType::STREAM, ProtocolType::TCP);
+	socket.SetSocketOption(SocketOption::REUSE_ADDRESS, 1);
+	if (reusePort) socket.SetSocketOption(SocketOption::REUSE_PORT, 1);
+
+	socket.Bind(sockaddr);
+	socket.Listen();
+	socket.SetBlocking(false);
+
+	return socket;
+}
+
+#ifndef NE_PLATFORM_WINDOWS
+
+// attaches a classic BPF program to the reuseport group that selects
+// the listener by the CPU the connection was received on (cpu % shardCount).
+static void AttachCpuSteering(const Socket& listener, const std::int32_t shardCount) {
+
+	struct sock_filter code[] = {
+		{ (BPF_LD | BPF_W | BPF_ABS), 0, 0, static_cast<std::uint32_t>(SKF_AD_OFF + SKF_AD_CPU) },
+		{ (BPF_ALU | BPF_MOD | BPF_K), 0, 0, static_cast<std::uint32_t>(shardCount) },
+		{ (BPF_RET | BPF_A), 0, 0, 0 },
+	};
+
+	struct sock_fprog program = { };
+	program.len = (sizeof(code) / sizeof(code[0]));
+	program.filter = code;
+
+	if (setsockopt(ToNativeHandle(listener.GetNativeSocketHandle()), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+}
+
+#endif
+
+ShardedListener::ShardedListener(const IpSocketAddress& sockaddr, const std::int32_t shardCount, const bool steerByCpu) {
+
+	if (shardCount < 1)
+		throw std::invalid_argument(ERR_BAD_SHARD_COUNT.data());
+
+	this->m_shardCount = shardCount;
+	this->m_running = false;
+
+#ifdef NE_PLATFORM_WINDOWS
+	// Windows has no SO_REUSEPORT load balancing, so all workers accept on the same socket.
+	this->m_listeners.push_back(CreateListener(sockaddr, false));
+#else
+	// the reuseport group indexes the sockets in the order they were bound,
+	// so listener i is the one the steering program selects for shard i.
+	this->m_listeners.reserve(shardCount);
+	this->m_listeners.push_back(CreateListener(sockaddr, true));
+
+	// if the port was chosen by the system, the other listeners must join the same port.
+	IpSocketAddress boundAddress;
+	this->m_listeners.front().GetSocketAddress(boundAddress);
+
+	for (std::int32_t i = 1; i < shardCount; ++i)
+		this->m_listeners.push_back(CreateListener(boundAddress, true));
+
+	if (steerByCpu) AttachCpuSteering(this->m_listeners.front(), shardCount);
+#endif
+
+}
+
+ShardedListener::ShardedListener(const IpSocketAddress& sockaddr, const std::int32_t shardCount)
+	: ShardedListener(sockaddr, shardCount, false) { }
+
+ShardedListener::ShardedListener(const IpSocketAddress& sockaddr)
+	: ShardedListener(sockaddr, std::max<std::int32_t>(std::thread::hardware_concurrency(), 1), true) { }
+
+ShardedListener::~ShardedListener() {
+	this->Stop();
+}
+
+std::int32_t ShardedListener::GetShardCount() const {
+	return this->m_shardCount;
+}
+
+const Socket& ShardedListener::GetListener(const std::int32_t shard) const {
+
+	if ((shard < 0) || (shard >= this->m_shardCount))
+		throw std::out_of_range(ERR_SHARD_OUT_OF_RANGE.data());
+
+	return this->m_listeners[(shard % this->m_listeners.size())];
+}
+
+void ShardedListener::Start(const ConnectionHandler& handler) {
+
+	if (this->m_running.exchange(true))
+		throw std::runtime_error(ERR_ALREADY_RUNNING.data());
+
+	this->m_workers.reserve(this->m_shardCount);
+	for (std::int32_t i = 0; i < this->m_shardCount; ++i)
+		this->m_workers.push_back(std::thread(&ShardedListener::WorkerThreadProc, this, i, handler));
+
+}
+
+void ShardedListener::Stop() {
+
+	this->m_running = false;
+
+	for (std::thread& worker : this->m_workers)
+		worker.join();
+
+	this->m_workers.clear();
+
+}
+
+void ShardedListener::WorkerThreadProc(const std::int32_t shard, const ConnectionHandler handler) {
+
+	PinCurrentThread(static_cast<std::uint32_t>(shard));
+
+	const Socket& listener = this->GetListener(shard);
+	while (this->m_running) {
+
+		// an exception escaping the thread would terminate the process,
+		// so a listener-level error only makes the worker back off and try again.
+		try {
+
+			// wait with a timeout, so the worker notices when the listener is stopped.
+			if (!WaitForConnections(listener)) continue;
+
+			// drain the accept queue; the listener is non-blocking, so TryAccept fails once it's empty.
+			while (this->m_running) {
+
+				std::optional<Socket> socket;
+				const SocketResult result = listener.TryAccept(socket);
+
+				if (result.WouldBlock) break;
+
+				if (result.ErrorCode != 0) {
+
+					if (IsConnectionAbortedError(result.ErrorCode)) continue;
+
+					// other errors (EMFILE, ENFILE, ENOBUFS, ...) leave the connection in the queue,
+					// so polling again right away would spin until the error goes away.
+					std::this_thread::sleep_for(std::chrono::milliseconds(ACCEPT_BACKOFF_INTERVAL));
+					break;
+				}
+
+#ifdef NE_PLATFORM_WINDOWS
+				// on Windows, accepted sockets inherit the listener's non-blocking mode.
+				socket->SetBlocking(true);
+#endif
+
+				// an exception from the handler would terminate the process, so it only closes the connection.
+				try { handler(shard, std::move(*socket)); }
+				catch (...) { }
+
+			}
+
+		}
+		catch (...) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(ACCEPT_BACKOFF_INTERVAL));
+		}
+
+	}
+
+}
\ No newline at end of file
@@ -1,40 +1,47 @@
 #include <Vnetworking/Sockets/Socket.h>
 #include <Vnetworking/Sockets/IpSocketAddress.h>
+#include <Vnetworking/Sockets/UnixSocketAddress.h>
+#include <Vnetworking/Sockets/AcceptedConnection.h>
+#include <Vnetworking/Sockets/IoContext.h>
 #include <Vnetworking/Sockets/SocketException.h>
+#include "Native.h"
 
-#define WIN32_LEAN_AND_MEAN
-#include <Windows.h>
-#include <WinSock2.h>
-#include <WS2tcpip.h>
-#include <iphlpapi.h>
-
+#include <cstring>
+#include <algorithm>
 #include <unordered_map>
+#include <chrono>
 #include <exception>
 #include <stdexcept>
 
-#pragma comment (lib, "WS2_32.lib")
-
-#ifdef ERROR
-#undef ERROR
-#endif
-
+using namespace Vnetworking;
 using namespace Vnetworking::Sockets;
+using namespace Vnetworking::Sockets::Private;
 
 // error messages for Send and Receive functions:
 constexpr std::string_view ERR_OFFSET_LESS_THAN_ZERO = "'offset' is less than zero.";
 constexpr std::string_view ERR_OFFSET_GREATER_THAN_BUFFERSIZE = "'offset' is greater than the buffer size.";
 constexpr std::string_view ERR_SIZE_LESS_THAN_ZERO = "'size' is less that zero.";
 constexpr std::string_view ERR_SIZE_GREATER_THAN_BUFFERSIZE_MINUS_OFFSET = "'size' is greater than the buffer size minus 'offset'.";
+constexpr std::string_view ERR_SIZE_GREATER_THAN_BUFFERSIZE = "'size' is greater than the buffer size.";
 
 constexpr std::string_view ERR_BAD_ISOCKETADDRESS_IMPL = "Invalid ISocketAddress implementation.";
 constexpr std::string_view ERR_BAD_ADDRESSFAMILY = "Invalid AddressFamily and/or ISocketAddress implementation.";
 constexpr std::string_view ERR_BAD_SOCKET = "Invalid socket.";
+constexpr std::string_view ERR_LENGTH_LESS_THAN_ZERO = "'length' is less than zero.";
+constexpr std::string_view ERR_BUFFERS_TOO_LARGE = "The total size of the buffers is too large.";
+constexpr std::string_view ERR_BAD_SEGMENT_SIZE = "'segmentSize' is less than or equal to zero.";
+constexpr std::string_view ERR_OPTION_NOT_SUPPORTED = "The socket option is not supported on this platform.";
+constexpr std::string_view ERR_TOO_MANY_DESCRIPTORS = "Too many descriptors.";
+constexpr std::string_view ERR_NO_SOCKET_RECEIVED = "No socket was received.";
+constexpr std::string_view ERR_NOT_MULTICAST = "'group' is not a multicast address.";
+constexpr std::string_view ERR_SOURCE_FAMILY_MISMATCH = "'source' and 'group' are not of the same IP version.";
 
 static const std::unordered_map<AddressFamily, std::int32_t> s_addressFamilies = { 
 
-	{ AddressFamily::UNSPECIFIED, NULL },
+	{ AddressFamily::UNSPECIFIED, 0 },
 	{ AddressFamily::IPV4, AF_INET },
 	{ AddressFamily::IPV6, AF_INET6 },
+	{ AddressFamily::UNIX, AF_UNIX },
 
 };
 
@@ -50,26 +57,38 @@ static const std::unordered_map<SocketType, std::int32_t> s_socketTypes = {
 
 static const std::unordered_map<ProtocolType, std::int32_t> s_protocolTypes = {
 
-	{ ProtocolType::UNSPECIFIED, NULL },
+	{ ProtocolType::UNSPECIFIED, 0 },
 	{ ProtocolType::TCP, IPPROTO_TCP },
 	{ ProtocolType::UDP, IPPROTO_UDP },
 
 };
 
-static const std::unordered_map<SocketFlags, std::int32_t> s_socketFlags = { 
-
-	{ SocketFlags::NONE, NULL },
-	{ SocketFlags::OUT_OF_BAND, MSG_OOB },
-	{ SocketFlags::PEEK, MSG_PEEK },
-	{ SocketFlags::DONT_ROUTE, MSG_DONTROUTE },
+// maps socket options to their level and name.
+static const std::unordered_map<SocketOption, std::pair<std::int32_t, std::int32_t>> s_socketOptions = {
+
+	{ SocketOption::NO_DELAY, { IPPROTO_TCP, TCP_NODELAY } },
+	{ SocketOption::REUSE_ADDRESS, { SOL_SOCKET, SO_REUSEADDR } },
+	{ SocketOption::SEND_BUFFER_SIZE, { SOL_SOCKET, SO_SNDBUF } },
+	{ SocketOption::RECEIVE_BUFFER_SIZE, { SOL_SOCKET, SO_RCVBUF } },
+	{ SocketOption::KEEP_ALIVE, { SOL_SOCKET, SO_KEEPALIVE } },
+	{ SocketOption::FAST_OPEN, { IPPROTO_TCP, TCP_FASTOPEN } },
+
+#ifndef NE_PLATFORM_WINDOWS
+	{ SocketOption::REUSE_PORT, { SOL_SOCKET, SO_REUSEPORT } },
+	{ SocketOption::CORK, { IPPROTO_TCP, TCP_CORK } },
+	{ SocketOption::QUICK_ACK, { IPPROTO_TCP, TCP_QUICKACK } },
+	{ SocketOption::BUSY_POLL, { SOL_SOCKET, SO_BUSY_POLL } },
+	{ SocketOption::FAST_OPEN_CONNECT, { IPPROTO_TCP, TCP_FASTOPEN_CONNECT } },
+	{ SocketOption::MAX_PACING_RATE, { SOL_SOCKET, SO_MAX_PACING_RATE } },
+#endif
 
 };
 
 Socket::Socket(const NativeSocket_t socket, const AddressFamily af, const SocketType type, const ProtocolType proto) 
-	: m_socket(socket), m_af(af), m_type(type), m_proto(proto) { }
+	: m_af(af), m_type(type), m_proto(proto), m_socket(socket) { }
 
 Socket::Socket(const AddressFamily af, const SocketType type, const ProtocolType proto) :
-	m_socket(INVALID_SOCKET_HANDLE), m_af(af), m_type(type), m_proto(proto) {
+	m_af(af), m_type(type), m_proto(proto), m_socket(INVALID_SOCKET_HANDLE) {
 	
 	std::int32_t addressFamily = -1;
 	std::int32_t socketType = -1;
@@ -81,7 +100,7 @@ Socket::Socket(const AddressFamily af, const SocketType type, const ProtocolType
 
 	this->m_socket = socket(addressFamily, socketType, protocolType);
 	if (this->m_socket == INVALID_SOCKET_HANDLE)
-		throw SocketException(WSAGetLastError());
+		throw SocketException(GetLastSocketError());
 
 }
 
@@ -104,6 +123,7 @@ Socket& Socket::operator= (Socket&& socket) noexcept {
 	this->m_type = socket.m_type;
 	this->m_proto = socket.m_proto;
 	this->m_socket = socket.m_socket;
+	this->m_rateLimiter = std::move(socket.m_rateLimiter);
 
 	socket.m_socket = INVALID_SOCKET_HANDLE;
 
@@ -141,8 +161,8 @@ void Socket::Close() {
 	if (this->m_socket == INVALID_SOCKET_HANDLE)
 		throw std::runtime_error(ERR_BAD_SOCKET.data());
 
-	if (closesocket(this->m_socket) == SOCKET_ERROR)
-		throw SocketException(static_cast<int>(WSAGetLastError()));
+	if (CloseNativeSocket(this->m_socket) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
 
 	this->m_socket = INVALID_SOCKET_HANDLE;
 
@@ -168,47 +188,15 @@ void Socket::Shutdown(const ShutdownSocket how) const {
 	}
 
 	if (shutdown(this->m_socket, sd))
-		throw SocketException(WSAGetLastError());
+		throw SocketException(GetLastSocketError());
 
 }
 
-// if successful, this function returns a pointer to addrinfo struct. 
-// once no longer needed, the object should be deleted using freeaddrinfo().
-// if the provided ISocketAddress implementation is for an unsupported address family, std::invalid_argument is thrown. 
-// if the provided ISocketAddress implementation is not valid for a specific address family, 
-// (ex. only IpSocketAddress is valid for IPV4 and IPV6. any other impl. would be considered invalid) std::invalid_argument is thrown.
-static struct addrinfo* CreateNativeAddrinfo(const Socket& socket, const ISocketAddress& sockaddr) {
-
-	if (sockaddr.GetAddressFamily() == AddressFamily::IPV4 || sockaddr.GetAddressFamily() == AddressFamily::IPV6) {
-
-		const IpSocketAddress* pIpSockaddr = dynamic_cast<const IpSocketAddress*>(&sockaddr);
-		if (pIpSockaddr == nullptr)
-			throw std::invalid_argument(ERR_BAD_ISOCKETADDRESS_IMPL.data());
-
-		struct addrinfo* result = NULL, * ptr = NULL, hints;
-		ZeroMemory(&hints, sizeof(hints));
-		hints.ai_family = s_addressFamilies.at(socket.GetAddressFamily());
-		hints.ai_socktype = s_socketTypes.at(socket.GetSocketType());
-		hints.ai_protocol = s_protocolTypes.at(socket.GetProtocolType());
-		hints.ai_flags = AI_PASSIVE;
-
-		int res = getaddrinfo(
-			pIpSockaddr->GetIpAddress().ToString().c_str(),
-			std::to_string(pIpSockaddr->GetPort()).c_str(),
-			&hints,
-			&result
-		);
-
-		if (res) throw SocketException(WSAGetLastError());
-
-		return result;
-	}
-
-	throw std::invalid_argument(ERR_BAD_ADDRESSFAMILY.data());
-	return nullptr;
+static inline const struct sockaddr* GetNativeSockaddr(const ISocketAddress& sockaddr) noexcept {
+	return reinterpret_cast<const struct sockaddr*>(sockaddr.GetNativeSocketAddress());
 }
 
-static void NativeSockaddrToISocketAddress(const Socket&, const struct sockaddr* source, ISocketAddress& destination) {
+static void NativeSockaddrToISocketAddress(const Socket&, const struct sockaddr* source, const socklen_t sourceLen, ISocketAddress& destination) {
 
 	if (destination.GetAddressFamily() == AddressFamily::IPV4 || destination.GetAddressFamily() == AddressFamily::IPV6) {
 
@@ -216,33 +204,18 @@ static void NativeSockaddrToISocketAddress(const Socket&, const struct sockaddr*
 		if (pDestination == nullptr)
 			throw std::invalid_argument(ERR_BAD_ISOCKETADDRESS_IMPL.data());
 
-		if (source->sa_family == AF_INET) {
-			const struct sockaddr_in* sockaddr = reinterpret_cast<const struct sockaddr_in*>(source);
-			const std::uint32_t a = sockaddr->sin_addr.S_un.S_addr;
-			const std::uint16_t p = sockaddr->sin_port;
-			pDestination->SetIpAddress({ (a & 0xFF), ((a >> 8) & 0xFF), ((a >> 16) & 0xFF), ((a >> 24) & 0xFF) });
-			pDestination->SetPort(static_cast<Vnetworking::Port>(((p & 0xFF) << 8) | ((p & 0xFF00) >> 8)));
-		}
-		else {
-
-			const struct sockaddr_in6* sockaddr = reinterpret_cast<const struct sockaddr_in6*>(source);
-			const std::uint16_t* a = sockaddr->sin6_addr.u.Word;
-			const std::uint16_t p = sockaddr->sin6_port;
-			std::array<std::uint8_t, 16> bytes;
-			std::size_t bytesPos = 0;
-
-			for (int i = 0; i < 8; ++i) {
-				const std::uint16_t* word = sockaddr->sin6_addr.u.Word;
-				const std::uint8_t l = ((word[i] >> 8) & 0xFF);
-				const std::uint8_t h = (word[i] & 0xFF);
-				bytes[bytesPos++] = h;
-				bytes[bytesPos++] = l;
-			}
+		pDestination->SetNativeSocketAddress(source, static_cast<std::int32_t>(sourceLen));
+
+		return;
+	}
 
-			pDestination->SetIpAddress({ bytes });
-			pDestination->SetPort(static_cast<Vnetworking::Port>(((p & 0xFF) << 8) | ((p & 0xFF00) >> 8)));
+	if (destination.GetAddressFamily() == AddressFamily::UNIX) {
 
-		}
+		UnixSocketAddress* pDestination = dynamic_cast<UnixSocketAddress*>(&destination);
+		if (pDestination == nullptr)
+			throw std::invalid_argument(ERR_BAD_ISOCKETADDRESS_IMPL.data());
+
+		pDestination->SetNativeSocketAddress(source, static_cast<std::int32_t>(sourceLen));
 
 		return;
 	}
@@ -251,42 +224,46 @@ static void NativeSockaddrToISocketAddress(const Socket&, const struct sockaddr*
 	return;
 }
 
-static std::int32_t CreateFlags(const SocketFlags flags) noexcept {
+void Socket::Bind(const ISocketAddress& sockaddr) const {
 
-	std::int32_t nf = 0;
-	for (const auto [key, val] : s_socketFlags) {
-		if (static_cast<bool>(flags & key)) nf |= val;
-	}
+	int res = bind(this->m_socket, GetNativeSockaddr(sockaddr), sockaddr.GetNativeSocketAddressLength());
+	if (res) throw SocketException(GetLastSocketError());
 
-	return nf;
 }
 
-void Socket::Bind(const ISocketAddress& sockaddr) const {
+void Socket::Connect(const ISocketAddress& sockaddr) const {
 
-	struct addrinfo* result = CreateNativeAddrinfo(static_cast<const Socket&>(*this), sockaddr);
+	int res = connect(this->m_socket, GetNativeSockaddr(sockaddr), sockaddr.GetNativeSocketAddressLength());
+	if (res) throw SocketException(GetLastSocketError());
 
-	int res = bind(this->m_socket, result->ai_addr, static_cast<int>(result->ai_addrlen));
-	if (res) {
-		freeaddrinfo(result);
-		throw SocketException(WSAGetLastError());
-	}
+}
 
-	freeaddrinfo(result);
+// connects with TCP Fast Open, sending the data in the SYN if the client has a Fast Open cookie for the server.
+// without a cookie, the data is sent once the connection is established, and the cookie is requested for the next time.
+// on a non-blocking socket without a cookie, nothing is sent and 0 is returned: the data has to be sent again once the socket is writable.
+// if Fast Open is disabled (net.ipv4.tcp_fastopen), or on Windows, this falls back to Connect followed by Send.
+std::int32_t Socket::ConnectWithData(const ISocketAddress& sockaddr, const std::span<const std::uint8_t>& data, const std::int32_t size) const {
 
-}
+	if (size < 0)
+		throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
 
-void Socket::Connect(const ISocketAddress& sockaddr) const {
+	if (size > data.size())
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE.data());
 
-	struct addrinfo* result = CreateNativeAddrinfo(static_cast<const Socket&>(*this), sockaddr);
+#ifndef NE_PLATFORM_WINDOWS
 
-	int res = connect(this->m_socket, result->ai_addr, static_cast<int>(result->ai_addrlen));
-	if (res) {
-		freeaddrinfo(result);
-		throw SocketException(WSAGetLastError());
-	}
+	const ssize_t sent = sendto(this->m_socket, data.data(), static_cast<std::size_t>(size), (MSG_FASTOPEN | MSG_NOSIGNAL), GetNativeSockaddr(sockaddr), sockaddr.GetNativeSocketAddressLength());
+	if (sent != SOCKET_ERROR)
+		return static_cast<std::int32_t>(sent);
 
-	freeaddrinfo(result);
+	const std::int32_t err = GetLastSocketError();
+	if (err == EINPROGRESS) return 0;
+	if (err != EOPNOTSUPP) throw SocketException(err);
 
+#endif
+
+	this->Connect(sockaddr);
+	return this->Send(data, size);
 }
 
 void Socket::Listen() const {
@@ -295,18 +272,133 @@ void Socket::Listen() const {
 
 void Socket::Listen(const std::int32_t backlog) const {
 	if (listen(this->m_socket, backlog) == SOCKET_ERROR)
-		throw SocketException(WSAGetLastError());
+		throw SocketException(GetLastSocketError());
+}
+
+// on Linux, accepted sockets are close-on-exec, so they don't leak into child processes.
+static inline NativeSocket_t AcceptNativeSocket(const NativeSocket_t socket) noexcept {
+#ifdef NE_PLATFORM_WINDOWS
+	return accept(socket, nullptr, nullptr);
+#else
+	return static_cast<NativeSocket_t>(accept4(ToNativeHandle(socket), nullptr, nullptr, SOCK_CLOEXEC));
+#endif
 }
 
 Socket Socket::Accept() const {
 
-	NativeSocket_t client = accept(this->m_socket, nullptr, nullptr);
-	if (client == INVALID_SOCKET)
-		throw SocketException(WSAGetLastError());
+	NativeSocket_t client = AcceptNativeSocket(this->m_socket);
+	if (client == INVALID_SOCKET_HANDLE)
+		throw SocketException(GetLastSocketError());
 
 	return Socket(client, this->GetAddressFamily(), this->GetSocketType(), this->GetProtocolType());
 }
 
+// accepts every connection that is waiting in the backlog (up to connections.size()) and returns how many were accepted.
+// the accepted sockets are non-blocking, and their peer addresses come from the accept call itself
+// (Unix domain sockets have no IP address, so for them the address is left as is).
+// on a blocking socket, only the first accept may block. the following ones are only made once poll reports
+// another connection, but a listener shared by several accepting threads must be non-blocking:
+// another thread can take that connection first, and accept would then block.
+std::int32_t Socket::AcceptMany(const std::span<AcceptedConnection>& connections) const {
+
+#ifndef NE_PLATFORM_WINDOWS
+	const int fileFlags = fcntl(this->m_socket, F_GETFL, 0);
+	const bool blocking = ((fileFlags != -1) && !(fileFlags & O_NONBLOCK));
+#else
+	const bool blocking = true; // Winsock can't tell whether a socket is non-blocking.
+#endif
+
+	std::size_t count = 0;
+	while (count < connections.size()) {
+
+		// a blocking socket is checked first, so accept never waits once the backlog is empty.
+		if ((count > 0) && blocking && !this->Poll(PollEvents::READ, 0)) break;
+
+		struct sockaddr_storage peer;
+		socklen_t peerLen = sizeof(peer);
+
+#ifdef NE_PLATFORM_WINDOWS
+		NativeSocket_t client = accept(this->m_socket, reinterpret_cast<struct sockaddr*>(&peer), &peerLen);
+#else
+		NativeSocket_t client = static_cast<NativeSocket_t>(accept4(this->m_socket, reinterpret_cast<struct sockaddr*>(&peer), &peerLen, (SOCK_NONBLOCK | SOCK_CLOEXEC)));
+#endif
+
+		if (client == INVALID_SOCKET_HANDLE) {
+			const std::int32_t err = GetLastSocketError();
+
+			// the connection was gone before it could be accepted, the others in the backlog can still be.
+			if (IsConnectionAbortedError(err)) continue;
+
+			if ((count > 0) || IsWouldBlockError(err)) break;
+			throw SocketException(err);
+		}
+
+		AcceptedConnection& connection = connections[count++];
+		connection.Client.emplace(Socket(client, this->GetAddressFamily(), this->GetSocketType(), this->GetProtocolType()));
+		if (this->m_af != AddressFamily::UNIX)
+			connection.Address.SetNativeSocketAddress(&peer, static_cast<std::int32_t>(peerLen));
+
+#ifdef NE_PLATFORM_WINDOWS
+		connection.Client->SetBlocking(false);
+#endif
+
+	}
+
+	return static_cast<std::int32_t>(count);
+}
+
+// the Try* functions report failures in a SocketResult instead of throwing, since on a
+// non-blocking socket an operation that would block is expected and happens all the time.
+static inline SocketResult CreateSocketResult(const std::int32_t bytes) noexcept {
+
+	if (bytes != SOCKET_ERROR)
+		return { bytes, 0, false, 0 };
+
+	const std::int32_t err = GetLastSocketError();
+	return { 0, err, IsWouldBlockError(err), 0 };
+}
+
+// gives back the rate limiter tokens of the data a send didn't send: all of them if nothing was sent
+// (the send failed or would block), or the bytes that weren't sent if the kernel took only part of the data.
+static void ReleaseUnsent(const std::shared_ptr<RateLimiter>& rateLimiter, const std::uint64_t bytes, const std::uint64_t packets, const std::int64_t sent) noexcept {
+
+	if (!rateLimiter) return;
+
+	try {
+		if (sent <= 0) rateLimiter->Release(bytes, packets);
+		else if (static_cast<std::uint64_t>(sent) < bytes) rateLimiter->Release((bytes - static_cast<std::uint64_t>(sent)), 0);
+	}
+	catch (...) { }
+
+}
+
+// the result of a Try* call that was held back by the socket's rate limiter. it is reported like a send that
+// would block, but the socket may well be writable, so RetryDelay tells when there will be enough tokens for the send.
+static SocketResult CreateRateLimitedResult(const RateLimiter& rateLimiter, const std::uint64_t bytes, const std::uint64_t packets) noexcept {
+
+	std::int64_t delay = 1;
+
+	try { delay = std::max<std::int64_t>(std::chrono::ceil<std::chrono::milliseconds>(rateLimiter.GetDelay(bytes, packets)).count(), 1); }
+	catch (...) { }
+
+#ifdef NE_PLATFORM_WINDOWS
+	return { 0, WSAEWOULDBLOCK, true, static_cast<std::int32_t>(std::min<std::int64_t>(delay, INT32_MAX)) };
+#else
+	return { 0, EWOULDBLOCK, true, static_cast<std::int32_t>(std::min<std::int64_t>(delay, INT32_MAX)) };
+#endif
+}
+
+SocketResult Socket::TryAccept(std::optional<Socket>& socket) const {
+
+	NativeSocket_t client = AcceptNativeSocket(this->m_socket);
+	if (client == INVALID_SOCKET_HANDLE)
+		return CreateSocketResult(SOCKET_ERROR);
+
+	socket.emplace(Socket(client, this->GetAddressFamily(), this->GetSocketType(), this->GetProtocolType()));
+
+	return CreateSocketResult(0);
+}
+
 std::int32_t Socket::Send(const std::span<const std::uint8_t>& data, const std::int32_t offset, const std::int32_t size, const SocketFlags flags) const {
 
 	if (offset < 0) 
@@ -322,10 +414,17 @@ std::int32_t Socket::Send(const std::span<const std::uint8_t>& data, const std::
 		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE_MINUS_OFFSET.data());
 
 	const char* buffer = (reinterpret_cast<const char*>(data.data()) + offset);
+
+	if (this->m_rateLimiter) this->m_rateLimiter->Acquire(size, 1);
 	
-	std::int32_t sent = send(this->m_socket, buffer, size, CreateFlags(flags));
-	if (sent == SOCKET_ERROR)
-		throw SocketException(WSAGetLastError());
+	std::int32_t sent = send(this->m_socket, buffer, size, CreateSendFlags(flags));
+	if (sent == SOCKET_ERROR) {
+		const std::int32_t err = GetLastSocketError();
+		ReleaseUnsent(this->m_rateLimiter, size, 1, 0);
+		throw SocketException(err);
+	}
+
+	ReleaseUnsent(this->m_rateLimiter, size, 1, sent);
 
 	return sent;
 }
@@ -356,7 +455,7 @@ std::int32_t Socket::Receive(const std::span<std::uint8_t>& data, const std::int
 
 	std::int32_t read = recv(this->m_socket, buffer, size, CreateFlags(flags));
 	if (read == SOCKET_ERROR)
-		throw SocketException(WSAGetLastError());
+		throw SocketException(GetLastSocketError());
 
 	return read;
 }
@@ -369,175 +468,1813 @@ std::int32_t Socket::Receive(const std::span<std::uint8_t>& data, const std::int
 	return this->Receive(data, 0, size, SocketFlags::NONE);
 }
 
-std::int32_t Socket::SendTo(
-	const std::span<const std::uint8_t>& data,
-	const std::int32_t offset,
+#ifndef NE_PLATFORM_WINDOWS
+
+// the timestamps requested by Socket::SetTimestamping: software timestamps for received and sent packets,
+// hardware timestamps if the network card generates them, and an id for every transmit timestamp.
+constexpr std::uint32_t TIMESTAMPING_FLAGS = (
+	SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_TX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE |
+	SOF_TIMESTAMPING_RX_HARDWARE | SOF_TIMESTAMPING_TX_HARDWARE | SOF_TIMESTAMPING_RAW_HARDWARE |
+	SOF_TIMESTAMPING_OPT_ID | SOF_TIMESTAMPING_OPT_TSONLY
+);
+
+static inline std::int64_t ToNanoseconds(const struct timespec& ts) noexcept {
+	return ((static_cast<std::int64_t>(ts.tv_sec) * 1000000000) + static_cast<std::int64_t>(ts.tv_nsec));
+}
+
+// reads the SCM_TIMESTAMPING control message, if there is one. returns false otherwise.
+static bool GetNativeTimestamp(struct msghdr& msg, SocketTimestamp& timestamp) noexcept {
+
+	for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if ((cmsg->cmsg_level == SOL_SOCKET) && (cmsg->cmsg_type == SCM_TIMESTAMPING)) {
+
+			struct scm_timestamping tss;
+			std::memcpy(&tss, CMSG_DATA(cmsg), sizeof(tss));
+
+			// ts[1] is deprecated and always zero.
+			timestamp.Software = ToNanoseconds(tss.ts[0]);
+			timestamp.Hardware = ToNanoseconds(tss.ts[2]);
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static std::int32_t ReceiveTimestamped(
+	const NativeSocket_t socket,
+	const std::span<std::uint8_t>& data,
 	const std::int32_t size,
 	const SocketFlags flags,
-	const ISocketAddress& sockaddr
-) const {
-	
-	if (offset < 0)
-		throw std::out_of_range(ERR_OFFSET_LESS_THAN_ZERO.data());
-
-	if (offset > data.size())
-		throw std::out_of_range(ERR_OFFSET_GREATER_THAN_BUFFERSIZE.data());
+	struct sockaddr_storage* sender,
+	socklen_t& senderLen,
+	SocketTimestamp& timestamp
+) {
 
 	if (size < 0)
 		throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
 
-	if (size > (data.size() - offset))
-		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE_MINUS_OFFSET.data());
+	if (size > data.size())
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE.data());
 
-	const char* buffer = (reinterpret_cast<const char*>(data.data()) + offset);
+	struct iovec iov = { };
+	iov.iov_base = data.data();
+	iov.iov_len = static_cast<std::size_t>(size);
 
-	struct addrinfo* result = CreateNativeAddrinfo(static_cast<const Socket&>(*this), sockaddr);
-	std::int32_t sent = sendto(this->m_socket, buffer, size, CreateFlags(flags), result->ai_addr, static_cast<int>(result->ai_addrlen));
-	if (sent == SOCKET_ERROR) {
-		freeaddrinfo(result);
-		throw SocketException(WSAGetLastError());
-	}
+	alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(struct scm_timestamping))];
 
-	freeaddrinfo(result);
+	struct msghdr msg = { };
+	msg.msg_name = sender;
+	msg.msg_namelen = ((sender != nullptr) ? sizeof(struct sockaddr_storage) : 0);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
 
-	return sent;
+	const ssize_t read = recvmsg(ToNativeHandle(socket), &msg, CreateFlags(flags));
+	if (read == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	timestamp = { };
+	GetNativeTimestamp(msg, timestamp);
+	senderLen = msg.msg_namelen;
+
+	return static_cast<std::int32_t>(read);
 }
 
-std::int32_t Socket::SendTo(
-	const std::span<const std::uint8_t>& data,
-	const std::int32_t size,
-	const SocketFlags flags,
-	const ISocketAddress& sockaddr
-) const {
-	return this->SendTo(data, 0, size, flags, sockaddr);
+#endif
+
+// receives data along with the kernel's receive timestamp of it. requires SetTimestamping(true),
+// otherwise (and on Windows) the timestamp is zeroed.
+std::int32_t Socket::Receive(const std::span<std::uint8_t>& data, const std::int32_t size, const SocketFlags flags, SocketTimestamp& timestamp) const {
+
+#ifdef NE_PLATFORM_WINDOWS
+	timestamp = { };
+	return this->Receive(data, 0, size, flags);
+#else
+	socklen_t senderLen = 0;
+	return ReceiveTimestamped(this->m_socket, data, size, flags, nullptr, senderLen, timestamp);
+#endif
+
 }
 
-std::int32_t Socket::SendTo(
-	const std::span<const std::uint8_t>& data,
-	const std::int32_t size,
-	const ISocketAddress& sockaddr
-) const {
-	return this->SendTo(data, size, SocketFlags::NONE, sockaddr);
+SocketResult Socket::TrySend(const std::span<const std::uint8_t>& data, const std::int32_t size, const SocketFlags flags) const noexcept {
+
+	// these functions don't throw, so a size that doesn't fit the buffer is clamped instead.
+	const std::int32_t clamped = static_cast<std::int32_t>(std::min<std::size_t>(std::max(size, 0), data.size()));
+
+	if (this->m_rateLimiter && !this->m_rateLimiter->TryAcquire(clamped, 1))
+		return CreateRateLimitedResult(*this->m_rateLimiter, clamped, 1);
+
+	const SocketResult result = CreateSocketResult(static_cast<std::int32_t>(send(this->m_socket, reinterpret_cast<const char*>(data.data()), clamped, CreateSendFlags(flags))));
+	ReleaseUnsent(this->m_rateLimiter, clamped, 1, result.Bytes);
+
+	return result;
 }
 
-std::int32_t Socket::ReceiveFrom(
-	const std::span<std::uint8_t>& data, 
-	const std::int32_t offset, 
-	const std::int32_t size, 
-	const SocketFlags flags, 
-	ISocketAddress& sockaddr
-) const {
-	
-	if (offset < 0)
-		throw std::out_of_range(ERR_OFFSET_LESS_THAN_ZERO.data());
+SocketResult Socket::TrySend(const std::span<const std::uint8_t>& data, const std::int32_t size) const noexcept {
+	return this->TrySend(data, size, SocketFlags::NONE);
+}
 
-	if (offset > data.size())
-		throw std::out_of_range(ERR_OFFSET_GREATER_THAN_BUFFERSIZE.data());
+SocketResult Socket::TryReceive(const std::span<std::uint8_t>& data, const std::int32_t size, const SocketFlags flags) const noexcept {
+
+	// these functions don't throw, so a size that doesn't fit the buffer is clamped instead.
+	const std::int32_t clamped = static_cast<std::int32_t>(std::min<std::size_t>(std::max(size, 0), data.size()));
+
+	return CreateSocketResult(static_cast<std::int32_t>(recv(this->m_socket, reinterpret_cast<char*>(data.data()), clamped, CreateFlags(flags))));
+}
+
+SocketResult Socket::TryReceive(const std::span<std::uint8_t>& data, const std::int32_t size) const noexcept {
+	return this->TryReceive(data, size, SocketFlags::NONE);
+}
+
+// the *Async functions are coroutines that run on an IoContext. the socket must be non-blocking
+// and must outlive the returned task. buffers are taken by value, since the task starts only when awaited,
+// but the data they point to, like the address passed to ConnectAsync, must outlive the task as well.
+// a socket that a task is waiting on must be cancelled with IoContext::Cancel before it is closed.
+
+Task<Socket> Socket::AcceptAsync(IoContext& context) const {
+
+	while (true) {
+
+		std::optional<Socket> socket;
+		const SocketResult result = this->TryAccept(socket);
+		
+		if (result.WouldBlock) {
+			co_await context.WaitAsync(*this, PollEvents::READ);
+			continue;
+		}
+
+		if (result.ErrorCode != 0)
+			throw SocketException(result.ErrorCode);
+
+		socket->SetBlocking(false);
+		co_return std::move(*socket);
+	}
+
+}
+
+Task<void> Socket::ConnectAsync(IoContext& context, const ISocketAddress& sockaddr) const {
+
+	if (connect(this->m_socket, GetNativeSockaddr(sockaddr), sockaddr.GetNativeSocketAddressLength()) != SOCKET_ERROR)
+		co_return;
+
+	const std::int32_t err = GetLastSocketError();
+#ifdef NE_PLATFORM_WINDOWS
+	if (err != WSAEWOULDBLOCK)
+#else
+	if (err != EINPROGRESS)
+#endif
+		throw SocketException(err);
+
+	co_await context.WaitAsync(*this, PollEvents::WRITE);
+
+	int result = 0;
+	socklen_t resultLen = sizeof(result);
+	if (getsockopt(this->m_socket, SOL_SOCKET, SO_ERROR, reinterpret_cast<char*>(&result), &resultLen) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	if (result != 0)
+		throw SocketException(static_cast<std::int32_t>(result));
+
+}
+
+// unlike Send, SendAsync completes only once all of the data has been sent.
+// a send held back by the socket's rate limiter waits on a timer, since the socket itself may be writable.
+Task<std::int32_t> Socket::SendAsync(IoContext& context, const std::span<const std::uint8_t> data, const std::int32_t size, const SocketFlags flags) const {
 
 	if (size < 0)
 		throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
 
-	if (size > (data.size() - offset))
-		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE_MINUS_OFFSET.data());
+	if (size > data.size())
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE.data());
 
-	char* buffer = (reinterpret_cast<char*>(data.data()) + offset);
+	std::int32_t sent = 0;
+	while (sent < size) {
 
-	struct sockaddr sender;
-	std::int32_t senderLen = sizeof(sender);
+		const SocketResult result = this->TrySend(data.subspan(sent), (size - sent), flags);
+		
+		if (result.RetryDelay > 0) co_await context.DelayAsync(result.RetryDelay);
+		else if (result.WouldBlock) co_await context.WaitAsync(*this, PollEvents::WRITE);
+		else if (result.ErrorCode != 0) throw SocketException(result.ErrorCode);
+		else sent += result.Bytes;
 
-	std::int32_t read = recvfrom(this->m_socket, buffer, size, CreateFlags(flags), &sender, &senderLen);
-	if (read == SOCKET_ERROR)
-		throw SocketException(WSAGetLastError());
+	}
 
-	NativeSockaddrToISocketAddress(static_cast<const Socket&>(*this), &sender, sockaddr);
+	co_return sent;
+}
 
-	return read;
+Task<std::int32_t> Socket::SendAsync(IoContext& context, const std::span<const std::uint8_t> data, const std::int32_t size) const {
+	return this->SendAsync(context, data, size, SocketFlags::NONE);
 }
 
-std::int32_t Socket::ReceiveFrom(
-	const std::span<std::uint8_t>& data,
-	const std::int32_t size,
-	const SocketFlags flags,
-	ISocketAddress& sockaddr
-) const {
-	return this->ReceiveFrom(data, 0, size, flags, sockaddr);
+Task<std::int32_t> Socket::ReceiveAsync(IoContext& context, const std::span<std::uint8_t> data, const std::int32_t size, const SocketFlags flags) const {
+
+	if (size < 0)
+		throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
+
+	if (size > data.size())
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE.data());
+
+	while (true) {
+
+		const SocketResult result = this->TryReceive(data, size, flags);
+		
+		if (result.WouldBlock) co_await context.WaitAsync(*this, PollEvents::READ);
+		else if (result.ErrorCode != 0) throw SocketException(result.ErrorCode);
+		else co_return result.Bytes;
+
+	}
+
 }
 
-std::int32_t Socket::ReceiveFrom(
-	const std::span<std::uint8_t>& data,
-	const std::int32_t size,
-	ISocketAddress& sockaddr
-) const {
-	return this->ReceiveFrom(data, size, SocketFlags::NONE, sockaddr);
+Task<std::int32_t> Socket::ReceiveAsync(IoContext& context, const std::span<std::uint8_t> data, const std::int32_t size) const {
+	return this->ReceiveAsync(context, data, size, SocketFlags::NONE);
 }
 
-std::int32_t Socket::GetAvailableBytes() const {
+// the maximum number of buffers passed to one vectored send/receive call.
+constexpr std::size_t MAX_BUFFERS_PER_CALL = 64;
 
-	u_long argp = 0;
-	int res = ioctlsocket(this->m_socket, FIONREAD, &argp);
-	if (res == SOCKET_ERROR)
-		throw SocketException(WSAGetLastError());
+template <typename T>
+static std::size_t GetTotalBufferSize(const std::span<const std::span<T>>& buffers) {
 
-	return static_cast<std::int32_t>(argp);
+	std::size_t total = 0;
+	for (const std::span<T>& buffer : buffers)
+		total += buffer.size();
+
+	if (total > static_cast<std::size_t>(INT32_MAX))
+		throw std::out_of_range(ERR_BUFFERS_TOO_LARGE.data());
+
+	return total;
 }
 
-void Socket::GetSocketAddress(ISocketAddress& sockaddr) const {
+std::int32_t Socket::SendV(const std::span<const std::span<const std::uint8_t>>& buffers, const SocketFlags flags) const {
 
-	struct sockaddr sockName;
-	std::int32_t sockNameLen = sizeof(sockName);
+	const std::size_t size = GetTotalBufferSize(buffers);
+	if (this->m_rateLimiter) this->m_rateLimiter->Acquire(size, 1);
+	
+	std::size_t total = 0;
+	std::size_t index = 0;
+	std::size_t offset = 0;
 
-	if (getsockname(this->m_socket, &sockName, &sockNameLen))
-		throw SocketException(WSAGetLastError());
+	// the kernel may accept only part of the data, so sending continues from
+	// the first byte that wasn't sent until everything is out.
+	while (total < size) {
 
-	NativeSockaddrToISocketAddress(static_cast<const Socket&>(*this), &sockName, sockaddr);
+		NativeBuffer_t nativeBuffers[MAX_BUFFERS_PER_CALL];
+		std::size_t count = 0;
 
-}
+		for (std::size_t i = index; (i < buffers.size()) && (count < MAX_BUFFERS_PER_CALL); ++i) {
+			
+			const std::size_t skip = ((i == index) ? offset : 0);
+			if (buffers[i].size() == skip) continue;
+			
+			SetNativeBuffer(nativeBuffers[count++], (buffers[i].data() + skip), (buffers[i].size() - skip));
 
-void Socket::GetPeerAddress(ISocketAddress& sockaddr) const {
+		}
+
+#ifdef NE_PLATFORM_WINDOWS
+		DWORD sent = 0;
+		int res = WSASend(this->m_socket, nativeBuffers, static_cast<DWORD>(count), &sent, static_cast<DWORD>(CreateSendFlags(flags)), nullptr, nullptr);
+#else
+		struct msghdr msg = { };
+		msg.msg_iov = nativeBuffers;
+		msg.msg_iovlen = count;
+
+		ssize_t sent = sendmsg(this->m_socket, &msg, CreateSendFlags(flags));
+		int res = ((sent == SOCKET_ERROR) ? SOCKET_ERROR : 0);
+#endif
 
-	struct sockaddr peerName;
-	std::int32_t peerNameLen = sizeof(peerName);
+		if (res == SOCKET_ERROR) {
 
-	if (getpeername(this->m_socket, &peerName, &peerNameLen))
-		throw SocketException(WSAGetLastError());
+			const std::int32_t err = GetLastSocketError();
 
-	NativeSockaddrToISocketAddress(static_cast<const Socket&>(*this), &peerName, sockaddr);
+			// a signal interrupted the send: continue where it stopped.
+#ifdef NE_PLATFORM_WINDOWS
+			if (err == WSAEINTR) continue;
+#else
+			if (err == EINTR) continue;
+#endif
+
+			// once some data is out, the error is not thrown, so the caller still learns how much was sent
+			// (e.g. a non-blocking socket ran out of buffer space). a lasting error is reported by the next send.
+			if (total > 0) break;
+
+			ReleaseUnsent(this->m_rateLimiter, size, 1, total);
+			throw SocketException(err);
+		}
+
+		total += static_cast<std::size_t>(sent);
+
+		// advance past the data that was sent:
+		std::size_t remaining = static_cast<std::size_t>(sent);
+		while ((index < buffers.size()) && (remaining >= (buffers[index].size() - offset))) {
+			remaining -= (buffers[index].size() - offset);
+			offset = 0;
+			++index;
+		}
+
+		offset += remaining;
 
+	}
+
+	ReleaseUnsent(this->m_rateLimiter, size, 1, total);
+
+	return static_cast<std::int32_t>(total);
 }
 
-static std::int16_t ToNativePollEvent(const PollEvents pollEvent) {
-	
-	switch (pollEvent) {
+std::int32_t Socket::SendV(const std::span<const std::span<const std::uint8_t>>& buffers) const {
+	return this->SendV(buffers, SocketFlags::NONE);
+}
 
-	case PollEvents::READ:
-		return POLLIN;
-		break;
+// sends as much of the buffers as the socket accepts with a single call (at most MAX_BUFFERS_PER_CALL buffers).
+SocketResult Socket::TrySendV(const std::span<const std::span<const std::uint8_t>>& buffers, const SocketFlags flags) const noexcept {
 
-	case PollEvents::WRITE:
-		return POLLOUT;
-		break;
+	NativeBuffer_t nativeBuffers[MAX_BUFFERS_PER_CALL];
+	std::size_t count = 0;
+	std::size_t total = 0;
 
-	case PollEvents::ERROR:
-		return POLLERR;
-		break;
+	for (std::size_t i = 0; (i < buffers.size()) && (count < MAX_BUFFERS_PER_CALL); ++i) {
 
-	default:
-		return 0;
-		break;
+		// like the other Try* functions, the total size is clamped instead of throwing.
+		const std::size_t size = std::min(buffers[i].size(), (static_cast<std::size_t>(INT32_MAX) - total));
+		if (size == 0) continue;
+
+		SetNativeBuffer(nativeBuffers[count++], buffers[i].data(), size);
+		total += size;
 
 	}
 
+	if (this->m_rateLimiter && !this->m_rateLimiter->TryAcquire(total, 1))
+		return CreateRateLimitedResult(*this->m_rateLimiter, total, 1);
+
+#ifdef NE_PLATFORM_WINDOWS
+	DWORD sent = 0;
+	const SocketResult result = CreateSocketResult((WSASend(this->m_socket, nativeBuffers, static_cast<DWORD>(count), &sent, static_cast<DWORD>(CreateSendFlags(flags)), nullptr, nullptr) == SOCKET_ERROR) ? SOCKET_ERROR : static_cast<std::int32_t>(sent));
+#else
+	struct msghdr msg = { };
+	msg.msg_iov = nativeBuffers;
+	msg.msg_iovlen = count;
+
+	const SocketResult result = CreateSocketResult(static_cast<std::int32_t>(sendmsg(this->m_socket, &msg, CreateSendFlags(flags))));
+#endif
+
+	ReleaseUnsent(this->m_rateLimiter, total, 1, result.Bytes);
+
+	return result;
 }
 
-bool Socket::Poll(const PollEvents pollEvent, const std::int32_t timeout) const {
+SocketResult Socket::TrySendV(const std::span<const std::span<const std::uint8_t>>& buffers) const noexcept {
+	return this->TrySendV(buffers, SocketFlags::NONE);
+}
 
-	WSAPOLLFD fd = { 0 };
-	fd.fd = this->m_socket;
-	fd.events = ToNativePollEvent(pollEvent);
+std::int32_t Socket::ReceiveV(const std::span<const std::span<std::uint8_t>>& buffers, const SocketFlags flags) const {
 
-	int result = WSAPoll(&fd, 1, timeout);
-	if (result == -1)
-		throw SocketException(static_cast<int>(WSAGetLastError()));
+	GetTotalBufferSize(buffers);
 
-	return (result > 0);
+	NativeBuffer_t nativeBuffers[MAX_BUFFERS_PER_CALL];
+	std::size_t count = 0;
+
+	// only the first MAX_BUFFERS_PER_CALL non-empty buffers are filled, like a single Receive call.
+	for (std::size_t i = 0; (i < buffers.size()) && (count < MAX_BUFFERS_PER_CALL); ++i) {
+		if (buffers[i].empty()) continue;
+		SetNativeBuffer(nativeBuffers[count++], buffers[i].data(), buffers[i].size());
+	}
+
+#ifdef NE_PLATFORM_WINDOWS
+	DWORD read = 0;
+	DWORD nf = static_cast<DWORD>(CreateFlags(flags));
+	if (WSARecv(this->m_socket, nativeBuffers, static_cast<DWORD>(count), &read, &nf, nullptr, nullptr) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+#else
+	struct msghdr msg = { };
+	msg.msg_iov = nativeBuffers;
+	msg.msg_iovlen = count;
+
+	const ssize_t read = recvmsg(this->m_socket, &msg, CreateFlags(flags));
+	if (read == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+#endif
+
+	return static_cast<std::int32_t>(read);
+}
+
+std::int32_t Socket::ReceiveV(const std::span<const std::span<std::uint8_t>>& buffers) const {
+	return this->ReceiveV(buffers, SocketFlags::NONE);
+}
+
+// MSG_ZEROCOPY pins the pages of the buffer instead of copying them into the kernel.
+// the buffer must stay unchanged until GetZeroCopyCompletions reports the call as completed.
+// on Windows, the data is always copied and the buffer can be reused as soon as the call returns.
+std::int32_t Socket::SendZeroCopy(const std::span<const std::uint8_t>& data, const std::int32_t size, const SocketFlags flags) const {
+
+	if (size < 0)
+		throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
+
+	if (size > data.size())
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE.data());
+
+#ifdef NE_PLATFORM_WINDOWS
+	const int nf = CreateSendFlags(flags);
+#else
+	const int nf = (CreateSendFlags(flags) | MSG_ZEROCOPY);
+#endif
+
+	if (this->m_rateLimiter) this->m_rateLimiter->Acquire(size, 1);
+
+	std::int32_t sent = send(this->m_socket, reinterpret_cast<const char*>(data.data()), size, nf);
+	if (sent == SOCKET_ERROR) {
+		const std::int32_t err = GetLastSocketError();
+		ReleaseUnsent(this->m_rateLimiter, size, 1, 0);
+		throw SocketException(err);
+	}
+
+	ReleaseUnsent(this->m_rateLimiter, size, 1, sent);
+
+	return sent;
+}
+
+std::int32_t Socket::SendZeroCopy(const std::span<const std::uint8_t>& data, const std::int32_t size) const {
+	return this->SendZeroCopy(data, size, SocketFlags::NONE);
+}
+
+std::int32_t Socket::GetZeroCopyCompletions(const std::span<ZeroCopyCompletion>& completions) const {
+
+	std::size_t count = 0;
+
+#ifndef NE_PLATFORM_WINDOWS
+
+	// completions are queued on the socket's error queue, which makes Poll/EventLoop report PollEvents::ERROR.
+	while (count < completions.size()) {
+
+		alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_storage))];
+
+		struct msghdr msg = { };
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+
+		if (recvmsg(this->m_socket, &msg, (MSG_ERRQUEUE | MSG_DONTWAIT)) == SOCKET_ERROR) {
+			const std::int32_t err = GetLastSocketError();
+			if (IsWouldBlockError(err)) break;
+			throw SocketException(err);
+		}
+
+		for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+
+			const bool isRecvErr = (((cmsg->cmsg_level == SOL_IP) && (cmsg->cmsg_type == IP_RECVERR)) ||
+				((cmsg->cmsg_level == SOL_IPV6) && (cmsg->cmsg_type == IPV6_RECVERR)));
+
+			if (!isRecvErr) continue;
+
+			struct sock_extended_err err;
+			std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+
+			if ((err.ee_errno != 0) || (err.ee_origin != SO_EE_ORIGIN_ZEROCOPY)) continue;
+
+			completions[count].First = err.ee_info;
+			completions[count].Last = err.ee_data;
+			completions[count].Copied = ((err.ee_code & SO_EE_CODE_ZEROCOPY_COPIED) != 0);
+			++count;
+			
+			break;
+		}
+
+	}
+
+#endif
+
+	return static_cast<std::int32_t>(count);
+}
+
+#ifndef NE_PLATFORM_WINDOWS
+
+// the largest number of bytes sendfile/splice transfer in one call.
+constexpr std::size_t MAX_SENDFILE_CHUNK = 0x7FFFF000;
+
+// sendfile and splice have no MSG_NOSIGNAL, so SIGPIPE is blocked on the calling thread while they run.
+// a SIGPIPE they raise is discarded before the signal mask is restored, unless one was already pending.
+class SigpipeBlocker {
+
+private:
+	sigset_t m_oldMask;
+	bool m_wasPending;
+
+public:
+	SigpipeBlocker(void) {
+
+		sigset_t pending;
+		sigemptyset(&pending);
+		sigpending(&pending);
+		this->m_wasPending = (sigismember(&pending, SIGPIPE) == 1);
+
+		sigset_t set;
+		sigemptyset(&set);
+		sigaddset(&set, SIGPIPE);
+		pthread_sigmask(SIG_BLOCK, &set, &this->m_oldMask);
+
+	}
+
+	SigpipeBlocker(const SigpipeBlocker&) = delete;
+	SigpipeBlocker& operator= (const SigpipeBlocker&) = delete;
+
+	~SigpipeBlocker(void) {
+
+		sigset_t pending;
+		sigemptyset(&pending);
+		sigpending(&pending);
+
+		if (!this->m_wasPending && (sigismember(&pending, SIGPIPE) == 1)) {
+			sigset_t set;
+			sigemptyset(&set);
+			sigaddset(&set, SIGPIPE);
+			const struct timespec timeout = { 0, 0 };
+			while ((sigtimedwait(&set, nullptr, &timeout) == -1) && (errno == EINTR));
+		}
+
+		pthread_sigmask(SIG_SETMASK, &this->m_oldMask, nullptr);
+
+	}
+
+};
+
+// moves file data to the socket through a pipe, for files that sendfile can't handle.
+// like sendfile, this returns the number of bytes sent so far once a non-blocking socket would block.
+static std::int64_t SpliceFile(const int socket, const int file, off_t offset, const std::int64_t length) {
+
+	int pipefd[2] = { -1, -1 };
+	if (pipe2(pipefd, O_CLOEXEC) == -1)
+		throw SocketException(GetLastSocketError());
+
+	std::int64_t total = 0;
+	std::int32_t err = 0;
+
+	while (total < length) {
+
+		const std::size_t chunk = static_cast<std::size_t>(std::min<std::int64_t>((length - total), MAX_SENDFILE_CHUNK));
+		
+		ssize_t filled = splice(file, &offset, pipefd[1], nullptr, chunk, SPLICE_F_MOVE);
+		if (filled <= 0) {
+			if (filled == -1) err = GetLastSocketError();
+			if (err == EINTR) {
+				err = 0;
+				continue;
+			}
+			break;
+		}
+
+		// drain the pipe into the socket. if the socket would block, the data left in the pipe is dropped:
+		// the caller only counts the bytes that were sent, and sends the rest from that offset again.
+		while (filled > 0) {
+			
+			const ssize_t sent = splice(pipefd[0], nullptr, socket, nullptr, static_cast<std::size_t>(filled), (SPLICE_F_MOVE | SPLICE_F_MORE));
+			if (sent == -1) {
+				if (GetLastSocketError() == EINTR) continue;
+				err = GetLastSocketError();
+				break;
+			}
+
+			filled -= sent;
+			total += sent;
+
+		}
+
+		if (err != 0) break;
+
+	}
+
+	close(pipefd[0]);
+	close(pipefd[1]);
+
+	if ((err != 0) && (total == 0))
+		throw SocketException(err);
+
+	return total;
+}
+
+#endif
+
+std::int64_t Socket::SendFile(const NativeFile_t file, const std::int64_t offset, const std::int64_t length) const {
+
+	if (offset < 0)
+		throw std::out_of_range(ERR_OFFSET_LESS_THAN_ZERO.data());
+
+	if (length < 0)
+		throw std::out_of_range(ERR_LENGTH_LESS_THAN_ZERO.data());
+
+	std::int64_t total = 0;
+
+#ifdef NE_PLATFORM_WINDOWS
+
+	const HANDLE hFile = reinterpret_cast<HANDLE>(file);
+
+	LARGE_INTEGER pos = { };
+	pos.QuadPart = offset;
+	if (!SetFilePointerEx(hFile, pos, nullptr, FILE_BEGIN))
+		throw SocketException(static_cast<std::int32_t>(GetLastError()));
+
+	// TransmitFile sends at most 2^31 - 2 bytes per call.
+	while (total < length) {
+
+		const DWORD chunk = static_cast<DWORD>(std::min<std::int64_t>((length - total), 0x7FFFFFFE));
+		if (!TransmitFile(this->m_socket, hFile, chunk, 0, nullptr, nullptr, 0)) {
+			if (total == 0) throw SocketException(GetLastSocketError());
+			break;
+		}
+
+		total += chunk;
+
+	}
+
+#else
+
+	off_t pos = static_cast<off_t>(offset);
+	const SigpipeBlocker sigpipeBlocker;
+
+	while (total < length) {
+
+		const std::size_t chunk = static_cast<std::size_t>(std::min<std::int64_t>((length - total), MAX_SENDFILE_CHUNK));
+		
+		const ssize_t sent = sendfile(this->m_socket, static_cast<int>(file), &pos, chunk);
+		if (sent == -1) {
+
+			const std::int32_t err = GetLastSocketError();
+			if (err == EINTR) continue;
+
+			// sendfile doesn't support every kind of file, splice handles the rest.
+			if ((total == 0) && ((err == EINVAL) || (err == ENOSYS)))
+				return SpliceFile(this->m_socket, static_cast<int>(file), pos, length);
+
+			// once some data is out, the error is not thrown, so the caller still learns how much was sent.
+			if (total > 0) break;
+			throw SocketException(err);
+		}
+
+		if (sent == 0) break; // end of file.
+		total += sent;
+
+	}
+
+#endif
+
+	return total;
+}
+
+std::int64_t Socket::SendFile(const std::filesystem::path& path, const std::int64_t offset, const std::int64_t length) const {
+
+#ifdef NE_PLATFORM_WINDOWS
+	
+	const HANDLE hFile = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE)
+		throw SocketException(static_cast<std::int32_t>(GetLastError()));
+
+	std::int64_t sent = 0;
+	try { sent = this->SendFile(reinterpret_cast<NativeFile_t>(hFile), offset, length); }
+	catch (...) {
+		CloseHandle(hFile);
+		throw;
+	}
+
+	CloseHandle(hFile);
+
+#else
+
+	const int fd = open(path.c_str(), (O_RDONLY | O_CLOEXEC));
+	if (fd == -1)
+		throw SocketException(GetLastSocketError());
+
+	std::int64_t sent = 0;
+	try { sent = this->SendFile(static_cast<NativeFile_t>(fd), offset, length); }
+	catch (...) {
+		close(fd);
+		throw;
+	}
+
+	close(fd);
+
+#endif
+
+	return sent;
+}
+
+std::int64_t Socket::SendFile(const std::filesystem::path& path) const {
+	return this->SendFile(path, 0, static_cast<std::int64_t>(std::filesystem::file_size(path)));
+}
+
+std::int32_t Socket::SendTo(
+	const std::span<const std::uint8_t>& data,
+	const std::int32_t offset,
+	const std::int32_t size,
+	const SocketFlags flags,
+	const ISocketAddress& sockaddr
+) const {
+	
+	if (offset < 0)
+		throw std::out_of_range(ERR_OFFSET_LESS_THAN_ZERO.data());
+
+	if (offset > data.size())
+		throw std::out_of_range(ERR_OFFSET_GREATER_THAN_BUFFERSIZE.data());
+
+	if (size < 0)
+		throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
+
+	if (size > (data.size() - offset))
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE_MINUS_OFFSET.data());
+
+	const char* buffer = (reinterpret_cast<const char*>(data.data()) + offset);
+
+	if (this->m_rateLimiter) this->m_rateLimiter->Acquire(size, 1);
+
+	std::int32_t sent = sendto(this->m_socket, buffer, size, CreateSendFlags(flags), GetNativeSockaddr(sockaddr), sockaddr.GetNativeSocketAddressLength());
+	if (sent == SOCKET_ERROR) {
+		const std::int32_t err = GetLastSocketError();
+		ReleaseUnsent(this->m_rateLimiter, size, 1, 0);
+		throw SocketException(err);
+	}
+
+	ReleaseUnsent(this->m_rateLimiter, size, 1, sent);
+
+	return sent;
+}
+
+std::int32_t Socket::SendTo(
+	const std::span<const std::uint8_t>& data,
+	const std::int32_t size,
+	const SocketFlags flags,
+	const ISocketAddress& sockaddr
+) const {
+	return this->SendTo(data, 0, size, flags, sockaddr);
+}
+
+std::int32_t Socket::SendTo(
+	const std::span<const std::uint8_t>& data,
+	const std::int32_t size,
+	const ISocketAddress& sockaddr
+) const {
+	return this->SendTo(data, size, SocketFlags::NONE, sockaddr);
+}
+
+std::int32_t Socket::ReceiveFrom(
+	const std::span<std::uint8_t>& data, 
+	const std::int32_t offset, 
+	const std::int32_t size, 
+	const SocketFlags flags, 
+	ISocketAddress& sockaddr
+) const {
+	
+	if (offset < 0)
+		throw std::out_of_range(ERR_OFFSET_LESS_THAN_ZERO.data());
+
+	if (offset > data.size())
+		throw std::out_of_range(ERR_OFFSET_GREATER_THAN_BUFFERSIZE.data());
+
+	if (size < 0)
+		throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
+
+	if (size > (data.size() - offset))
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE_MINUS_OFFSET.data());
+
+	char* buffer = (reinterpret_cast<char*>(data.data()) + offset);
+
+	struct sockaddr_storage sender;
+	socklen_t senderLen = sizeof(sender);
+
+	std::int32_t read = recvfrom(this->m_socket, buffer, size, CreateFlags(flags), reinterpret_cast<struct sockaddr*>(&sender), &senderLen);
+	if (read == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	NativeSockaddrToISocketAddress(static_cast<const Socket&>(*this), reinterpret_cast<const struct sockaddr*>(&sender), senderLen, sockaddr);
+
+	return read;
+}
+
+std::int32_t Socket::ReceiveFrom(
+	const std::span<std::uint8_t>& data,
+	const std::int32_t size,
+	const SocketFlags flags,
+	ISocketAddress& sockaddr
+) const {
+	return this->ReceiveFrom(data, 0, size, flags, sockaddr);
+}
+
+std::int32_t Socket::ReceiveFrom(
+	const std::span<std::uint8_t>& data,
+	const std::int32_t size,
+	ISocketAddress& sockaddr
+) const {
+	return this->ReceiveFrom(data, size, SocketFlags::NONE, sockaddr);
+}
+
+std::int32_t Socket::ReceiveFrom(
+	const std::span<std::uint8_t>& data,
+	const std::int32_t size,
+	const SocketFlags flags,
+	ISocketAddress& sockaddr,
+	SocketTimestamp& timestamp
+) const {
+
+#ifdef NE_PLATFORM_WINDOWS
+	timestamp = { };
+	return this->ReceiveFrom(data, 0, size, flags, sockaddr);
+#else
+	struct sockaddr_storage sender;
+	socklen_t senderLen = 0;
+
+	const std::int32_t read = ReceiveTimestamped(this->m_socket, data, size, flags, &sender, senderLen, timestamp);
+	NativeSockaddrToISocketAddress(static_cast<const Socket&>(*this), reinterpret_cast<const struct sockaddr*>(&sender), senderLen, sockaddr);
+
+	return read;
+#endif
+
+}
+
+// transmit timestamps are queued on the socket's error queue, which makes Poll/EventLoop report PollEvents::ERROR.
+// the error queue is shared with zero-copy completions, so the two shouldn't be used on the same socket.
+std::int32_t Socket::GetTransmitTimestamps(const std::span<TransmitTimestamp>& timestamps) const {
+
+	std::size_t count = 0;
+
+#ifndef NE_PLATFORM_WINDOWS
+
+	while (count < timestamps.size()) {
+
+		alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(struct scm_timestamping)) + CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_storage))];
+
+		struct msghdr msg = { };
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+
+		if (recvmsg(this->m_socket, &msg, (MSG_ERRQUEUE | MSG_DONTWAIT)) == SOCKET_ERROR) {
+			const std::int32_t err = GetLastSocketError();
+			if (IsWouldBlockError(err)) break;
+			throw SocketException(err);
+		}
+
+		SocketTimestamp timestamp = { };
+		if (!GetNativeTimestamp(msg, timestamp)) continue;
+
+		for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+
+			const bool isRecvErr = (((cmsg->cmsg_level == SOL_IP) && (cmsg->cmsg_type == IP_RECVERR)) ||
+				((cmsg->cmsg_level == SOL_IPV6) && (cmsg->cmsg_type == IPV6_RECVERR)));
+
+			if (!isRecvErr) continue;
+
+			struct sock_extended_err err;
+			std::memcpy(&err, CMSG_DATA(cmsg), sizeof(err));
+
+			if ((err.ee_errno != ENOMSG) || (err.ee_origin != SO_EE_ORIGIN_TIMESTAMPING)) continue;
+
+			timestamps[count].Id = err.ee_data;
+			timestamps[count].Timestamp = timestamp;
+			++count;
+
+			break;
+		}
+
+	}
+
+#endif
+
+	return static_cast<std::int32_t>(count);
+}
+
+#ifndef NE_PLATFORM_WINDOWS
+// the maximum number of datagrams passed to one sendmmsg/recvmmsg call.
+constexpr std::size_t MAX_DATAGRAMS_PER_CALL = 64;
+#endif
+
+std::int32_t Socket::SendToBatch(const std::span<const OutgoingDatagram>& datagrams, const SocketFlags flags) const {
+
+	for (const OutgoingDatagram& datagram : datagrams) {
+
+		if (datagram.Size < 0)
+			throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
+
+		if (static_cast<std::size_t>(datagram.Size) > datagram.Buffer.size())
+			throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE.data());
+
+	}
+
+	if (this->m_rateLimiter) {
+		std::uint64_t bytes = 0;
+		for (const OutgoingDatagram& datagram : datagrams) bytes += static_cast<std::uint64_t>(datagram.Size);
+		this->m_rateLimiter->Acquire(bytes, datagrams.size());
+	}
+
+	std::size_t total = 0;
+	std::int32_t err = 0;
+
+#ifdef NE_PLATFORM_WINDOWS
+
+	// Winsock has no sendmmsg equivalent for UDP, so datagrams are sent one at a time.
+	for (const OutgoingDatagram& datagram : datagrams) {
+
+		const char* buffer = reinterpret_cast<const char*>(datagram.Buffer.data());
+		const std::int32_t sent = sendto(this->m_socket, buffer, datagram.Size, CreateSendFlags(flags), GetNativeSockaddr(datagram.Address), datagram.Address.GetNativeSocketAddressLength());
+		
+		if (sent == SOCKET_ERROR) {
+			err = GetLastSocketError();
+			break;
+		}
+
+		++total;
+
+	}
+
+#else
+
+	struct mmsghdr messages[MAX_DATAGRAMS_PER_CALL];
+	struct iovec iov[MAX_DATAGRAMS_PER_CALL];
+
+	while (total < datagrams.size()) {
+
+		const std::size_t count = std::min((datagrams.size() - total), MAX_DATAGRAMS_PER_CALL);
+
+		for (std::size_t i = 0; i < count; ++i) {
+			
+			const OutgoingDatagram& datagram = datagrams[total + i];
+			
+			iov[i].iov_base = const_cast<std::uint8_t*>(datagram.Buffer.data());
+			iov[i].iov_len = static_cast<std::size_t>(datagram.Size);
+
+			std::memset(&messages[i], 0, sizeof(struct mmsghdr));
+			messages[i].msg_hdr.msg_name = const_cast<void*>(datagram.Address.GetNativeSocketAddress());
+			messages[i].msg_hdr.msg_namelen = static_cast<socklen_t>(datagram.Address.GetNativeSocketAddressLength());
+			messages[i].msg_hdr.msg_iov = &iov[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+
+		}
+
+		const int sent = sendmmsg(this->m_socket, messages, static_cast<unsigned int>(count), CreateSendFlags(flags));
+		if (sent == SOCKET_ERROR) {
+			err = GetLastSocketError();
+			break;
+		}
+
+		total += static_cast<std::size_t>(sent);
+		if (static_cast<std::size_t>(sent) < count) break;
+
+	}
+
+#endif
+
+	// give back the tokens of the datagrams that weren't sent.
+	if (this->m_rateLimiter && (total < datagrams.size())) {
+		std::uint64_t bytes = 0;
+		for (std::size_t i = total; i < datagrams.size(); ++i) bytes += static_cast<std::uint64_t>(datagrams[i].Size);
+		ReleaseUnsent(this->m_rateLimiter, bytes, (datagrams.size() - total), 0);
+	}
+
+	if ((total == 0) && (err != 0))
+		throw SocketException(err);
+
+	return static_cast<std::int32_t>(total);
+}
+
+std::int32_t Socket::SendToBatch(const std::span<const OutgoingDatagram>& datagrams) const {
+	return this->SendToBatch(datagrams, SocketFlags::NONE);
+}
+
+std::int32_t Socket::ReceiveFromBatch(const std::span<IncomingDatagram>& datagrams, const SocketFlags flags) const {
+
+	std::size_t total = 0;
+
+#ifdef NE_PLATFORM_WINDOWS
+
+	// without recvmmsg, the first datagram is waited for and the rest are read only while data is queued.
+	for (IncomingDatagram& datagram : datagrams) {
+
+		if ((total > 0) && (this->GetAvailableBytes() == 0)) break;
+
+		struct sockaddr_storage sender;
+		socklen_t senderLen = sizeof(sender);
+		
+		char* buffer = reinterpret_cast<char*>(datagram.Buffer.data());
+		std::int32_t read = recvfrom(this->m_socket, buffer, static_cast<int>(datagram.Buffer.size()), CreateFlags(flags), reinterpret_cast<struct sockaddr*>(&sender), &senderLen);
+		datagram.Truncated = false;
+
+		if (read == SOCKET_ERROR) {
+
+			const std::int32_t err = GetLastSocketError();
+			if (err == WSAEMSGSIZE) {
+				read = static_cast<std::int32_t>(datagram.Buffer.size());
+				datagram.Truncated = true;
+			}
+			else {
+				if (total == 0) throw SocketException(err);
+				break;
+			}
+
+		}
+
+		datagram.Size = read;
+		datagram.Address.SetNativeSocketAddress(&sender, static_cast<std::int32_t>(senderLen));
+		++total;
+
+	}
+
+#else
+
+	struct mmsghdr messages[MAX_DATAGRAMS_PER_CALL];
+	struct iovec iov[MAX_DATAGRAMS_PER_CALL];
+	struct sockaddr_storage senders[MAX_DATAGRAMS_PER_CALL];
+
+	while (total < datagrams.size()) {
+
+		const std::size_t count = std::min((datagrams.size() - total), MAX_DATAGRAMS_PER_CALL);
+
+		for (std::size_t i = 0; i < count; ++i) {
+
+			IncomingDatagram& datagram = datagrams[total + i];
+
+			iov[i].iov_base = datagram.Buffer.data();
+			iov[i].iov_len = datagram.Buffer.size();
+
+			std::memset(&messages[i], 0, sizeof(struct mmsghdr));
+			messages[i].msg_hdr.msg_name = &senders[i];
+			messages[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_storage);
+			messages[i].msg_hdr.msg_iov = &iov[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+
+		}
+
+		// block for the first datagram only, then take whatever else is already queued.
+		const int nf = (CreateFlags(flags) | ((total == 0) ? MSG_WAITFORONE : MSG_DONTWAIT));
+		
+		const int read = recvmmsg(this->m_socket, messages, static_cast<unsigned int>(count), nf, nullptr);
+		if (read == SOCKET_ERROR) {
+			if (total == 0) throw SocketException(GetLastSocketError());
+			break;
+		}
+
+		for (int i = 0; i < read; ++i) {
+			IncomingDatagram& datagram = datagrams[total + i];
+			datagram.Size = static_cast<std::int32_t>(messages[i].msg_len);
+			datagram.Truncated = ((messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0);
+			datagram.Address.SetNativeSocketAddress(&senders[i], static_cast<std::int32_t>(messages[i].msg_hdr.msg_namelen));
+		}
+
+		total += static_cast<std::size_t>(read);
+		if (static_cast<std::size_t>(read) < count) break;
+
+	}
+
+#endif
+
+	return static_cast<std::int32_t>(total);
+}
+
+std::int32_t Socket::ReceiveFromBatch(const std::span<IncomingDatagram>& datagrams) const {
+	return this->ReceiveFromBatch(datagrams, SocketFlags::NONE);
+}
+
+std::int32_t Socket::SendToSegmented(
+	const std::span<const std::uint8_t>& data,
+	const std::int32_t size,
+	const std::int32_t segmentSize,
+	const SocketFlags flags,
+	const ISocketAddress& sockaddr
+) const {
+
+	if (size < 0)
+		throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
+
+	if (size > data.size())
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE.data());
+
+	if (segmentSize <= 0)
+		throw std::out_of_range(ERR_BAD_SEGMENT_SIZE.data());
+
+	const std::int32_t segments = ((size + segmentSize - 1) / segmentSize);
+	if (this->m_rateLimiter) this->m_rateLimiter->Acquire(size, segments);
+
+#ifdef NE_PLATFORM_WINDOWS
+
+	// no segmentation offload here: every segment is sent as its own datagram.
+	std::int32_t sent = 0;
+	while (sent < size) {
+
+		const std::int32_t len = std::min(segmentSize, (size - sent));
+		const char* buffer = (reinterpret_cast<const char*>(data.data()) + sent);
+
+		if (sendto(this->m_socket, buffer, len, CreateSendFlags(flags), GetNativeSockaddr(sockaddr), sockaddr.GetNativeSocketAddressLength()) == SOCKET_ERROR) {
+			
+			if (sent == 0) {
+				const std::int32_t err = GetLastSocketError();
+				ReleaseUnsent(this->m_rateLimiter, size, segments, 0);
+				throw SocketException(err);
+			}
+
+			// give back the tokens of the segments that weren't sent.
+			ReleaseUnsent(this->m_rateLimiter, (size - sent), (segments - ((sent + segmentSize - 1) / segmentSize)), 0);
+			break;
+		}
+
+		sent += len;
+
+	}
+
+	return sent;
+
+#else
+
+	// the kernel splits the buffer into segmentSize datagrams (the last one may be shorter),
+	// which is done by the NIC if it supports UDP segmentation offload.
+	struct iovec iov = { };
+	iov.iov_base = const_cast<std::uint8_t*>(data.data());
+	iov.iov_len = static_cast<std::size_t>(size);
+
+	alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(std::uint16_t))] = { 0 };
+
+	struct msghdr msg = { };
+	msg.msg_name = const_cast<void*>(sockaddr.GetNativeSocketAddress());
+	msg.msg_namelen = static_cast<socklen_t>(sockaddr.GetNativeSocketAddressLength());
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+
+	// a buffer that fits into one segment is sent as a regular datagram.
+	if (size > segmentSize) {
+
+		msg.msg_control = control;
+		msg.msg_controllen = sizeof(control);
+
+		struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+		cmsg->cmsg_level = SOL_UDP;
+		cmsg->cmsg_type = UDP_SEGMENT;
+		cmsg->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+
+		const std::uint16_t gsoSize = static_cast<std::uint16_t>(segmentSize);
+		std::memcpy(CMSG_DATA(cmsg), &gsoSize, sizeof(gsoSize));
+
+	}
+
+	// a datagram is sent completely or not at all, so the tokens are only given back if the send failed.
+	const ssize_t sent = sendmsg(this->m_socket, &msg, CreateSendFlags(flags));
+	if (sent == SOCKET_ERROR) {
+		const std::int32_t err = GetLastSocketError();
+		ReleaseUnsent(this->m_rateLimiter, size, segments, 0);
+		throw SocketException(err);
+	}
+
+	return static_cast<std::int32_t>(sent);
+
+#endif
+
+}
+
+std::int32_t Socket::SendToSegmented(
+	const std::span<const std::uint8_t>& data,
+	const std::int32_t size,
+	const std::int32_t segmentSize,
+	const ISocketAddress& sockaddr
+) const {
+	return this->SendToSegmented(data, size, segmentSize, SocketFlags::NONE, sockaddr);
+}
+
+std::int32_t Socket::ReceiveFromCoalesced(
+	const std::span<std::uint8_t>& data,
+	const std::int32_t size,
+	const SocketFlags flags,
+	ISocketAddress& sockaddr,
+	std::int32_t& segmentSize
+) const {
+
+	if (size < 0)
+		throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
+
+	if (size > data.size())
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE.data());
+
+#ifdef NE_PLATFORM_WINDOWS
+
+	const std::int32_t read = this->ReceiveFrom(data, size, flags, sockaddr);
+	segmentSize = read;
+
+	return read;
+
+#else
+
+	struct iovec iov = { };
+	iov.iov_base = data.data();
+	iov.iov_len = static_cast<std::size_t>(size);
+
+	struct sockaddr_storage sender;
+	alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))] = { 0 };
+
+	struct msghdr msg = { };
+	msg.msg_name = &sender;
+	msg.msg_namelen = sizeof(sender);
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = sizeof(control);
+
+	const ssize_t read = recvmsg(this->m_socket, &msg, CreateFlags(flags));
+	if (read == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	// without a UDP_GRO control message, a single datagram was received.
+	segmentSize = static_cast<std::int32_t>(read);
+	for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		if ((cmsg->cmsg_level == SOL_UDP) && (cmsg->cmsg_type == UDP_GRO)) {
+			int gsoSize = 0;
+			std::memcpy(&gsoSize, CMSG_DATA(cmsg), sizeof(gsoSize));
+			segmentSize = static_cast<std::int32_t>(gsoSize);
+		}
+	}
+
+	NativeSockaddrToISocketAddress(static_cast<const Socket&>(*this), reinterpret_cast<const struct sockaddr*>(&sender), msg.msg_namelen, sockaddr);
+
+	return static_cast<std::int32_t>(read);
+
+#endif
+
+}
+
+std::int32_t Socket::ReceiveFromCoalesced(
+	const std::span<std::uint8_t>& data,
+	const std::int32_t size,
+	ISocketAddress& sockaddr,
+	std::int32_t& segmentSize
+) const {
+	return this->ReceiveFromCoalesced(data, size, SocketFlags::NONE, sockaddr, segmentSize);
+}
+
+#ifndef NE_PLATFORM_WINDOWS
+
+// the maximum number of descriptors passed in one message (SCM_MAX_FD in the kernel).
+constexpr std::size_t MAX_DESCRIPTORS_PER_CALL = 253;
+
+// finds the enum value that maps to a native value, e.g. the address family of a received socket.
+template <typename T>
+static T FromNativeValue(const std::unordered_map<T, std::int32_t>& values, const std::int32_t value, const T fallback) noexcept {
+
+	for (const auto& [key, val] : values)
+		if (val == value) return key;
+
+	return fallback;
+}
+
+#endif
+
+// sends data along with open descriptors (SCM_RIGHTS) over a Unix domain socket.
+// the receiving process gets its own duplicates, so the descriptors can be closed once the call returns.
+// at least one byte of data has to be sent with the descriptors. not supported on Windows.
+std::int32_t Socket::SendDescriptors(const std::span<const std::uint8_t>& data, const std::int32_t size, const std::span<const NativeSocket_t>& descriptors) const {
+
+	if (size < 0)
+		throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
+
+	if (size > data.size())
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE.data());
+
+#ifdef NE_PLATFORM_WINDOWS
+	throw SocketException(WSAEOPNOTSUPP);
+#else
+
+	if (descriptors.size() > MAX_DESCRIPTORS_PER_CALL)
+		throw std::invalid_argument(ERR_TOO_MANY_DESCRIPTORS.data());
+
+	struct iovec iov = { };
+	iov.iov_base = const_cast<std::uint8_t*>(data.data());
+	iov.iov_len = static_cast<std::size_t>(size);
+
+	alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_DESCRIPTORS_PER_CALL)];
+
+	struct msghdr msg = { };
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+
+	if (!descriptors.empty()) {
+
+		msg.msg_control = control;
+		msg.msg_controllen = CMSG_SPACE(sizeof(int) * descriptors.size());
+
+		struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+		cmsg->cmsg_level = SOL_SOCKET;
+		cmsg->cmsg_type = SCM_RIGHTS;
+		cmsg->cmsg_len = CMSG_LEN(sizeof(int) * descriptors.size());
+
+		for (std::size_t i = 0; i < descriptors.size(); ++i) {
+			const int fd = ToNativeHandle(descriptors[i]);
+			std::memcpy((CMSG_DATA(cmsg) + (sizeof(int) * i)), &fd, sizeof(fd));
+		}
+
+	}
+
+	const ssize_t sent = sendmsg(this->m_socket, &msg, MSG_NOSIGNAL);
+	if (sent == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	return static_cast<std::int32_t>(sent);
+
+#endif
+
+}
+
+// receives data along with the descriptors sent with it, and returns the number of descriptors in count.
+// the received descriptors are owned by the caller. if more descriptors were sent than fit in 'descriptors',
+// the rest are closed and truncated is set to true. not supported on Windows.
+std::int32_t Socket::ReceiveDescriptors(const std::span<std::uint8_t>& data, const std::int32_t size, const std::span<NativeSocket_t>& descriptors, std::int32_t& count, bool& truncated) const {
+
+	if (size < 0)
+		throw std::out_of_range(ERR_SIZE_LESS_THAN_ZERO.data());
+
+	if (size > data.size())
+		throw std::out_of_range(ERR_SIZE_GREATER_THAN_BUFFERSIZE.data());
+
+#ifdef NE_PLATFORM_WINDOWS
+	throw SocketException(WSAEOPNOTSUPP);
+#else
+
+	struct iovec iov = { };
+	iov.iov_base = data.data();
+	iov.iov_len = static_cast<std::size_t>(size);
+
+	alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int) * MAX_DESCRIPTORS_PER_CALL)];
+
+	struct msghdr msg = { };
+	msg.msg_iov = &iov;
+	msg.msg_iovlen = 1;
+	msg.msg_control = control;
+	msg.msg_controllen = CMSG_SPACE(sizeof(int) * std::min(descriptors.size(), MAX_DESCRIPTORS_PER_CALL));
+
+	const ssize_t read = recvmsg(this->m_socket, &msg, MSG_CMSG_CLOEXEC);
+	if (read == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	// the kernel closes the descriptors that didn't fit in the control buffer, and sets MSG_CTRUNC.
+	count = 0;
+	truncated = ((msg.msg_flags & MSG_CTRUNC) != 0);
+
+	for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+		
+		if ((cmsg->cmsg_level != SOL_SOCKET) || (cmsg->cmsg_type != SCM_RIGHTS)) continue;
+
+		// CMSG_SPACE rounds the control buffer up, so it can hold more descriptors than were asked for.
+		// those are already installed in this process, and are closed here.
+		const std::size_t received = ((cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+		for (std::size_t i = 0; i < received; ++i) {
+			
+			int fd = -1;
+			std::memcpy(&fd, (CMSG_DATA(cmsg) + (sizeof(int) * i)), sizeof(fd));
+
+			if (static_cast<std::size_t>(count) < descriptors.size()) descriptors[count++] = static_cast<NativeSocket_t>(fd);
+			else {
+				close(fd);
+				truncated = true;
+			}
+
+		}
+
+	}
+
+	return static_cast<std::int32_t>(read);
+
+#endif
+
+}
+
+std::int32_t Socket::ReceiveDescriptors(const std::span<std::uint8_t>& data, const std::int32_t size, const std::span<NativeSocket_t>& descriptors, std::int32_t& count) const {
+	bool truncated = false;
+	return this->ReceiveDescriptors(data, size, descriptors, count, truncated);
+}
+
+// passes a socket to the process on the other end of a Unix domain socket, e.g. an accepted
+// connection or a listener handed over to a new process during a restart.
+// the socket stays open in this process too, and can be closed once it has been sent.
+void Socket::SendSocket(const Socket& socket) const {
+
+	if (socket.m_socket == INVALID_SOCKET_HANDLE)
+		throw std::invalid_argument(ERR_BAD_SOCKET.data());
+
+	const std::uint8_t data[1] = { 0 };
+	const NativeSocket_t descriptors[1] = { socket.m_socket };
+
+	this->SendDescriptors(data, 1, descriptors);
+
+}
+
+// receives a socket sent with SendSocket.
+Socket Socket::ReceiveSocket() const {
+
+#ifdef NE_PLATFORM_WINDOWS
+	throw SocketException(WSAEOPNOTSUPP);
+#else
+
+	std::uint8_t data[1] = { 0 };
+	NativeSocket_t descriptors[1] = { INVALID_SOCKET_HANDLE };
+	std::int32_t count = 0;
+
+	this->ReceiveDescriptors(data, 1, descriptors, count);
+	if (count == 0)
+		throw std::runtime_error(ERR_NO_SOCKET_RECEIVED.data());
+
+	// the received socket's family, type and protocol are queried from the kernel.
+	const int fd = ToNativeHandle(descriptors[0]);
+	int domain = 0, type = 0, protocol = 0;
+	socklen_t len = sizeof(int);
+
+	if ((getsockopt(fd, SOL_SOCKET, SO_DOMAIN, &domain, &len) == SOCKET_ERROR) ||
+		(getsockopt(fd, SOL_SOCKET, SO_TYPE, &type, &len) == SOCKET_ERROR) ||
+		(getsockopt(fd, SOL_SOCKET, SO_PROTOCOL, &protocol, &len) == SOCKET_ERROR)) {
+		
+		const std::int32_t err = GetLastSocketError();
+		CloseNativeSocket(descriptors[0]);
+		throw SocketException(err);
+	}
+
+	return Socket(
+		descriptors[0],
+		FromNativeValue(s_addressFamilies, domain, AddressFamily::UNSPECIFIED),
+		FromNativeValue(s_socketTypes, type, SocketType::STREAM),
+		FromNativeValue(s_protocolTypes, protocol, ProtocolType::UNSPECIFIED)
+	);
+
+#endif
+
+}
+
+std::int32_t Socket::GetAvailableBytes() const {
+
+#ifdef NE_PLATFORM_WINDOWS
+	u_long argp = 0;
+	int res = ioctlsocket(this->m_socket, FIONREAD, &argp);
+#else
+	int argp = 0;
+	int res = ioctl(this->m_socket, FIONREAD, &argp);
+#endif
+	if (res == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	return static_cast<std::int32_t>(argp);
+}
+
+void Socket::GetSocketAddress(ISocketAddress& sockaddr) const {
+
+	struct sockaddr_storage sockName;
+	socklen_t sockNameLen = sizeof(sockName);
+
+	if (getsockname(this->m_socket, reinterpret_cast<struct sockaddr*>(&sockName), &sockNameLen))
+		throw SocketException(GetLastSocketError());
+
+	NativeSockaddrToISocketAddress(static_cast<const Socket&>(*this), reinterpret_cast<const struct sockaddr*>(&sockName), sockNameLen, sockaddr);
+
+}
+
+void Socket::GetPeerAddress(ISocketAddress& sockaddr) const {
+
+	struct sockaddr_storage peerName;
+	socklen_t peerNameLen = sizeof(peerName);
+
+	if (getpeername(this->m_socket, reinterpret_cast<struct sockaddr*>(&peerName), &peerNameLen))
+		throw SocketException(GetLastSocketError());
+
+	NativeSockaddrToISocketAddress(static_cast<const Socket&>(*this), reinterpret_cast<const struct sockaddr*>(&peerName), peerNameLen, sockaddr);
+
+}
+
+static std::int16_t ToNativePollEvent(const PollEvents pollEvent) {
+	
+	std::int16_t events = 0;
+	
+	if (static_cast<bool>(pollEvent & PollEvents::READ)) events |= POLLIN;
+	if (static_cast<bool>(pollEvent & PollEvents::WRITE)) events |= POLLOUT;
+	if (static_cast<bool>(pollEvent & PollEvents::ERROR)) events |= POLLERR;
+	if (static_cast<bool>(pollEvent & PollEvents::HANGUP)) events |= POLLHUP;
+
+	return events;
+}
+
+bool Socket::Poll(const PollEvents pollEvent, const std::int32_t timeout) const {
+
+	NativePollFd_t fd = { };
+	fd.fd = ToNativeHandle(this->m_socket);
+	fd.events = ToNativePollEvent(pollEvent);
+
+	int result = PollNativeSockets(&fd, 1, timeout);
+	if (result == -1)
+		throw SocketException(GetLastSocketError());
+
+	return (result > 0);
+}
+
+// samples the connection's TCP state with a single getsockopt/WSAIoctl call and no allocations,
+// so it's cheap enough to be called for every event from an event loop.
+TransportInfo Socket::GetTransportInfo() const {
+
+	TransportInfo info = { };
+
+#ifdef NE_PLATFORM_WINDOWS
+	DWORD version = 0;
+	TCP_INFO_v0 nativeInfo = { };
+	DWORD bytes = 0;
+
+	if (WSAIoctl(this->m_socket, SIO_TCP_INFO, &version, sizeof(version), &nativeInfo, sizeof(nativeInfo), &bytes, nullptr, nullptr) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	info.Rtt = static_cast<std::uint32_t>(nativeInfo.RttUs);
+	info.MinRtt = static_cast<std::uint32_t>(nativeInfo.MinRttUs);
+	info.MaxSegmentSize = static_cast<std::uint32_t>(nativeInfo.Mss);
+	info.CongestionWindow = static_cast<std::uint64_t>(nativeInfo.Cwnd);
+	info.BytesInFlight = static_cast<std::uint64_t>(nativeInfo.BytesInFlight);
+	info.Retransmits = static_cast<std::uint32_t>(nativeInfo.FastRetrans + nativeInfo.TimeoutEpisodes);
+	info.BytesRetransmitted = static_cast<std::uint64_t>(nativeInfo.BytesRetrans);
+	info.BytesSent = static_cast<std::uint64_t>(nativeInfo.BytesOut);
+	info.BytesReceived = static_cast<std::uint64_t>(nativeInfo.BytesIn);
+#else
+	NativeTcpInfo nativeInfo = { };
+	socklen_t nativeInfoLen = sizeof(nativeInfo);
+
+	if (getsockopt(this->m_socket, IPPROTO_TCP, TCP_INFO, &nativeInfo, &nativeInfoLen) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	const std::uint64_t mss = nativeInfo.SndMss;
+
+	info.Rtt = nativeInfo.Rtt;
+	info.RttVariance = nativeInfo.RttVar;
+	info.MinRtt = nativeInfo.MinRtt;
+	info.MaxSegmentSize = nativeInfo.SndMss;
+	info.CongestionWindow = (static_cast<std::uint64_t>(nativeInfo.SndCwnd) * mss);
+
+	// the kernel's packets in flight: sent and not acknowledged, minus the segments
+	// that were selectively acknowledged or are presumed lost, plus the retransmissions.
+	const std::int64_t inFlight = (static_cast<std::int64_t>(nativeInfo.Unacked) - nativeInfo.Sacked - nativeInfo.Lost + nativeInfo.Retrans);
+	info.BytesInFlight = ((inFlight > 0) ? (static_cast<std::uint64_t>(inFlight) * mss) : 0);
+
+	info.Retransmits = nativeInfo.TotalRetrans;
+	info.BytesRetransmitted = nativeInfo.BytesRetrans;
+	info.BytesSent = nativeInfo.BytesSent;
+	info.BytesReceived = nativeInfo.BytesReceived;
+	info.PacingRate = ((nativeInfo.PacingRate == ~0ull) ? 0 : nativeInfo.PacingRate); // ~0 means the connection isn't paced.
+	info.DeliveryRate = nativeInfo.DeliveryRate;
+#endif
+
+	return info;
+}
+
+// returns the CPU that processed the socket's most recent incoming packets, or -1 if unknown.
+// on Windows, this is the CPU that RSS assigned to the connection.
+std::int32_t Socket::GetIncomingCpu() const {
+
+#ifdef NE_PLATFORM_WINDOWS
+	SOCKET_PROCESSOR_AFFINITY affinity = { };
+	DWORD bytes = 0;
+
+	if (WSAIoctl(this->m_socket, SIO_QUERY_RSS_PROCESSOR_INFO, nullptr, 0, &affinity, sizeof(affinity), &bytes, nullptr, nullptr) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	return ((static_cast<std::int32_t>(affinity.Processor.Group) * 64) + affinity.Processor.Number);
+#else
+	std::int32_t cpu = -1;
+	socklen_t cpuLen = sizeof(cpu);
+
+	if (getsockopt(this->m_socket, SOL_SOCKET, SO_INCOMING_CPU, &cpu, &cpuLen) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	return cpu;
+#endif
+
+}
+
+// returns the id of the NAPI context (the NIC receive queue) the socket's packets arrive on,
+// or 0 if unknown, e.g. for loopback connections, or on systems without busy polling support.
+std::uint32_t Socket::GetNapiId() const {
+
+#ifdef NE_PLATFORM_WINDOWS
+	return 0;
+#else
+	std::uint32_t napiId = 0;
+	socklen_t napiIdLen = sizeof(napiId);
+
+	if (getsockopt(this->m_socket, SOL_SOCKET, SO_INCOMING_NAPI_ID, &napiId, &napiIdLen) == SOCKET_ERROR) {
+		const std::int32_t error = GetLastSocketError();
+		if (error == ENOPROTOOPT) return 0;
+		throw SocketException(error);
+	}
+
+	return napiId;
+#endif
+
+}
+
+void Socket::SetSocketOption(const SocketOption option, const std::int32_t value) const {
+
+	if (!s_socketOptions.contains(option))
+		throw std::invalid_argument(ERR_OPTION_NOT_SUPPORTED.data());
+
+	const auto& [level, name] = s_socketOptions.at(option);
+
+	const int val = static_cast<int>(value);
+	if (setsockopt(this->m_socket, level, name, reinterpret_cast<const char*>(&val), sizeof(val)) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+}
+
+std::int32_t Socket::GetSocketOption(const SocketOption option) const {
+
+	if (!s_socketOptions.contains(option))
+		throw std::invalid_argument(ERR_OPTION_NOT_SUPPORTED.data());
+
+	const auto& [level, name] = s_socketOptions.at(option);
+
+	// on Linux, SO_SNDBUF and SO_RCVBUF read back as twice the value that was set,
+	// since the kernel reserves the extra space for bookkeeping.
+	int val = 0;
+	socklen_t valLen = sizeof(val);
+	if (getsockopt(this->m_socket, level, name, reinterpret_cast<char*>(&val), &valLen) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+	return static_cast<std::int32_t>(val);
+}
+
+void Socket::SetBlocking(const bool blocking) const {
+
+#ifdef NE_PLATFORM_WINDOWS
+	u_long mode = (blocking ? 0 : 1);
+	if (ioctlsocket(this->m_socket, FIONBIO, &mode) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+#else
+	int flags = fcntl(this->m_socket, F_GETFL, 0);
+	if (flags == -1)
+		throw SocketException(GetLastSocketError());
+
+	flags = (blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK));
+	if (fcntl(this->m_socket, F_SETFL, flags) == -1)
+		throw SocketException(GetLastSocketError());
+#endif
+
+}
+
+void Socket::SetReceiveCoalescing(const bool enabled) const {
+
+#ifndef NE_PLATFORM_WINDOWS
+	const int val = (enabled ? 1 : 0);
+	if (setsockopt(this->m_socket, SOL_UDP, UDP_GRO, &val, sizeof(val)) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+#endif
+
+}
+
+void Socket::SetZeroCopy(const bool enabled) const {
+
+#ifndef NE_PLATFORM_WINDOWS
+	const int val = (enabled ? 1 : 0);
+	if (setsockopt(this->m_socket, SOL_SOCKET, SO_ZEROCOPY, &val, sizeof(val)) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+#endif
+
+}
+
+// enables kernel timestamps for received and sent data, see Receive/ReceiveFrom with a SocketTimestamp and GetTransmitTimestamps.
+// stream sockets must be connected before timestamping is enabled. on Windows, this function does nothing.
+void Socket::SetTimestamping(const bool enabled) const {
+
+#ifndef NE_PLATFORM_WINDOWS
+	const int val = static_cast<int>(enabled ? TIMESTAMPING_FLAGS : 0);
+	if (setsockopt(this->m_socket, SOL_SOCKET, SO_TIMESTAMPING, &val, sizeof(val)) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+#endif
+
+}
+
+// sets the rate the kernel paces the socket's packets at, in bytes per second (SO_MAX_PACING_RATE, Linux only).
+// unlike SetSocketOption(SocketOption::MAX_PACING_RATE, ...), it takes rates above 2^31 - 1 bytes per second.
+void Socket::SetMaxPacingRate(const std::uint64_t rate) const {
+
+#ifdef NE_PLATFORM_WINDOWS
+	throw SocketException(WSAEOPNOTSUPP);
+#else
+	const std::uint64_t val = rate;
+	if (setsockopt(this->m_socket, SOL_SOCKET, SO_MAX_PACING_RATE, &val, sizeof(val)) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+#endif
+
+}
+
+// joins or leaves a multicast group, optionally receiving only the datagrams sent by one source (source-specific multicast).
+// the protocol-independent MCAST_* options take an interface index for both IPv4 and IPv6. 0 lets the system pick the interface.
+static void ChangeMulticastMembership(const NativeSocket_t socket, const bool join, const IpAddress& group, const IpAddress* source, const std::uint32_t interfaceIndex) {
+
+	if (!group.IsMulticastAddress())
+		throw std::invalid_argument(ERR_NOT_MULTICAST.data());
+
+	if ((source != nullptr) && (source->IsVersion6() != group.IsVersion6()))
+		throw std::invalid_argument(ERR_SOURCE_FAMILY_MISMATCH.data());
+
+	const int level = (group.IsVersion6() ? IPPROTO_IPV6 : IPPROTO_IP);
+	const IpSocketAddress groupAddress(group, 0);
+
+	int res = 0;
+	if (source == nullptr) {
+
+		struct group_req req = { };
+		req.gr_interface = interfaceIndex;
+		std::memcpy(&req.gr_group, groupAddress.GetNativeSocketAddress(), groupAddress.GetNativeSocketAddressLength());
+
+		res = setsockopt(ToNativeHandle(socket), level, (join ? MCAST_JOIN_GROUP : MCAST_LEAVE_GROUP), reinterpret_cast<const char*>(&req), sizeof(req));
+
+	}
+	else {
+
+		const IpSocketAddress sourceAddress(*source, 0);
+
+		struct group_source_req req = { };
+		req.gsr_interface = interfaceIndex;
+		std::memcpy(&req.gsr_group, groupAddress.GetNativeSocketAddress(), groupAddress.GetNativeSocketAddressLength());
+		std::memcpy(&req.gsr_source, sourceAddress.GetNativeSocketAddress(), sourceAddress.GetNativeSocketAddressLength());
+
+		res = setsockopt(ToNativeHandle(socket), level, (join ? MCAST_JOIN_SOURCE_GROUP : MCAST_LEAVE_SOURCE_GROUP), reinterpret_cast<const char*>(&req), sizeof(req));
+
+	}
+
+	if (res == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+}
+
+// to receive the group's datagrams, the socket has to be bound to the group's port
+// (and to the group address or the wildcard address).
+void Socket::JoinMulticastGroup(const IpAddress& group, const std::uint32_t interfaceIndex) const {
+	ChangeMulticastMembership(this->m_socket, true, group, nullptr, interfaceIndex);
+}
+
+void Socket::JoinMulticastGroup(const IpAddress& group) const {
+	ChangeMulticastMembership(this->m_socket, true, group, nullptr, 0);
+}
+
+void Socket::JoinMulticastGroup(const IpAddress& group, const IpAddress& source, const std::uint32_t interfaceIndex) const {
+	ChangeMulticastMembership(this->m_socket, true, group, &source, interfaceIndex);
+}
+
+void Socket::LeaveMulticastGroup(const IpAddress& group, const std::uint32_t interfaceIndex) const {
+	ChangeMulticastMembership(this->m_socket, false, group, nullptr, interfaceIndex);
+}
+
+void Socket::LeaveMulticastGroup(const IpAddress& group) const {
+	ChangeMulticastMembership(this->m_socket, false, group, nullptr, 0);
+}
+
+void Socket::LeaveMulticastGroup(const IpAddress& group, const IpAddress& source, const std::uint32_t interfaceIndex) const {
+	ChangeMulticastMembership(this->m_socket, false, group, &source, interfaceIndex);
+}
+
+// sets the interface that multicast datagrams are sent from (0 lets the system pick it by route).
+void Socket::SetMulticastInterface(const std::uint32_t interfaceIndex) const {
+
+	int res = 0;
+	if (this->m_af == AddressFamily::IPV6) {
+		const int val = static_cast<int>(interfaceIndex);
+		res = setsockopt(this->m_socket, IPPROTO_IPV6, IPV6_MULTICAST_IF, reinterpret_cast<const char*>(&val), sizeof(val));
+	}
+	else {
+#ifdef NE_PLATFORM_WINDOWS
+		// an address in the 0.0.0.0/8 range is taken as an interface index.
+		const DWORD val = htonl(interfaceIndex);
+#else
+		struct ip_mreqn val = { };
+		val.imr_ifindex = static_cast<int>(interfaceIndex);
+#endif
+		res = setsockopt(this->m_socket, IPPROTO_IP, IP_MULTICAST_IF, reinterpret_cast<const char*>(&val), sizeof(val));
+	}
+
+	if (res == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+}
+
+// sets how many routers multicast datagrams may cross (IP_MULTICAST_TTL, or IPV6_MULTICAST_HOPS for IPv6 sockets).
+// the default is 1, which keeps them on the local network.
+void Socket::SetMulticastTimeToLive(const std::int32_t ttl) const {
+
+	const int val = static_cast<int>(ttl);
+	const bool ipv6 = (this->m_af == AddressFamily::IPV6);
+
+	if (setsockopt(this->m_socket, (ipv6 ? IPPROTO_IPV6 : IPPROTO_IP), (ipv6 ? IPV6_MULTICAST_HOPS : IP_MULTICAST_TTL), reinterpret_cast<const char*>(&val), sizeof(val)) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+}
+
+// sets whether multicast datagrams sent by this socket are delivered to group members on the same host.
+void Socket::SetMulticastLoopback(const bool enabled) const {
+
+	const int val = (enabled ? 1 : 0);
+	const bool ipv6 = (this->m_af == AddressFamily::IPV6);
+
+	if (setsockopt(this->m_socket, (ipv6 ? IPPROTO_IPV6 : IPPROTO_IP), (ipv6 ? IPV6_MULTICAST_LOOP : IP_MULTICAST_LOOP), reinterpret_cast<const char*>(&val), sizeof(val)) == SOCKET_ERROR)
+		throw SocketException(GetLastSocketError());
+
+}
+
+// limits the rate at which this socket sends data. the same RateLimiter can be set on several sockets,
+// to limit the group as a whole. Send, SendTo, SendV, SendZeroCopy, SendToBatch and SendToSegmented
+// wait for the limiter, while TrySend and TrySendV fail as if they would block. pass nullptr to remove the limiter.
+// on Linux, SocketOption::MAX_PACING_RATE makes the kernel pace the data on the wire as well.
+void Socket::SetRateLimiter(const std::shared_ptr<RateLimiter>& rateLimiter) {
+	this->m_rateLimiter = rateLimiter;
+}
+
+std::shared_ptr<RateLimiter> Socket::GetRateLimiter() const {
+	return this->m_rateLimiter;
 }
\ No newline at end of file
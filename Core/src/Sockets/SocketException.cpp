@@ -1,14 +1,19 @@
 #include <Vnetworking/Sockets/SocketException.h>
+#include <Vnetworking/Platform.h>
 
+#ifdef NE_PLATFORM_WINDOWS
 #define WIN32_LEAN_AND_MEAN
 #include <Windows.h>
+#else
+#include <cstring>
+#endif
 
 using namespace Vnetworking::Sockets;
 
-static std::string GetErrorMessage(const DWORD) noexcept;
+static std::string GetErrorMessage(const std::int32_t) noexcept;
 
 SocketException::SocketException(const std::int32_t errorCode) : 
-	std::runtime_error(GetErrorMessage(static_cast<DWORD>(errorCode))), m_errorCode(errorCode) { }
+	std::runtime_error(GetErrorMessage(errorCode)), m_errorCode(errorCode) { }
 
 SocketException::SocketException(const std::int32_t errorCode, const std::string& message) :
 	std::runtime_error(message), m_errorCode(errorCode) { }
@@ -26,8 +31,11 @@ std::int32_t SocketException::GetErrorCode() const {
 	return this->m_errorCode;
 }
 
-static std::string GetErrorMessage(const DWORD dwErrorCode) noexcept {
+#ifdef NE_PLATFORM_WINDOWS
 
+static std::string GetErrorMessage(const std::int32_t errorCode) noexcept {
+
+	const DWORD dwErrorCode = static_cast<DWORD>(errorCode);
 	LPSTR pszMessage = NULL;
 
 	FormatMessageA(
@@ -45,4 +53,12 @@ static std::string GetErrorMessage(const DWORD dwErrorCode) noexcept {
 	pszMessage = NULL;
 
 	return str;
-}
\ No newline at end of file
+}
+
+#else
+
+static std::string GetErrorMessage(const std::int32_t errorCode) noexcept {
+	return std::string { std::strerror(errorCode) };
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include <Vnetworking/Sockets/UnixSocketAddress.h>
+#include "Native.h"
+
+#include <cstring>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+
+using namespace Vnetworking;
+using namespace Vnetworking::Sockets;
+
+static_assert(sizeof(struct sockaddr_un) <= UNIX_NATIVE_SOCKADDR_SIZE, "UNIX_NATIVE_SOCKADDR_SIZE is too small.");
+
+constexpr std::string_view ERR_PATH_TOO_LONG = "The path is too long for a Unix domain socket address.";
+constexpr std::string_view ERR_PATH_CONTAINS_NULL = "The path contains a null character.";
+constexpr std::string_view ERR_BAD_NATIVE_SOCKADDR = "The native socket address is not a valid Unix domain socket address.";
+
+// the size of sockaddr_un without the path.
+constexpr std::size_t SUN_PATH_OFFSET = offsetof(struct sockaddr_un, sun_path);
+
+// the longest path that fits in sockaddr_un, leaving room for the null terminator (or the leading null of an abstract name).
+constexpr std::size_t MAX_PATH_LENGTH = (sizeof(sockaddr_un::sun_path) - 1);
+
+UnixSocketAddress::UnixSocketAddress() : m_abstract(false) {
+	this->UpdateNativeSocketAddress();
+}
+
+UnixSocketAddress::UnixSocketAddress(const std::string_view path) : UnixSocketAddress(path, false) { }
+
+UnixSocketAddress::UnixSocketAddress(const std::string_view path, const bool abstract) {
+	this->SetPath(path, abstract);
+}
+
+UnixSocketAddress::UnixSocketAddress(const UnixSocketAddress& sockaddr) {
+	this->operator= (sockaddr);
+}
+
+UnixSocketAddress::UnixSocketAddress(UnixSocketAddress&& sockaddr) noexcept {
+	this->operator= (std::move(sockaddr));
+}
+
+UnixSocketAddress::~UnixSocketAddress() { }
+
+UnixSocketAddress& UnixSocketAddress::operator= (const UnixSocketAddress& sockaddr) {
+	this->m_path = sockaddr.m_path;
+	this->m_abstract = sockaddr.m_abstract;
+	this->m_sockaddr = sockaddr.m_sockaddr;
+	this->m_sockaddrLen = sockaddr.m_sockaddrLen;
+	return static_cast<UnixSocketAddress&>(*this);
+}
+
+UnixSocketAddress& UnixSocketAddress::operator= (UnixSocketAddress&& sockaddr) noexcept {
+	this->m_path = std::move(sockaddr.m_path);
+	this->m_abstract = sockaddr.m_abstract;
+	this->m_sockaddr = std::move(sockaddr.m_sockaddr);
+	this->m_sockaddrLen = sockaddr.m_sockaddrLen;
+	return static_cast<UnixSocketAddress&>(*this);
+}
+
+bool UnixSocketAddress::operator== (const UnixSocketAddress& sockaddr) const {
+	return ((this->m_abstract == sockaddr.m_abstract) && (this->m_path == sockaddr.m_path));
+}
+
+AddressFamily UnixSocketAddress::GetAddressFamily() const {
+	return AddressFamily::UNIX;
+}
+
+const std::string& UnixSocketAddress::GetPath() const {
+	return this->m_path;
+}
+
+bool UnixSocketAddress::IsAbstract() const {
+	return this->m_abstract;
+}
+
+bool UnixSocketAddress::IsUnnamed() const {
+	return this->m_path.empty();
+}
+
+void UnixSocketAddress::SetPath(const std::string_view path, const bool abstract) {
+
+	if (path.size() > MAX_PATH_LENGTH)
+		throw std::invalid_argument(ERR_PATH_TOO_LONG.data());
+
+	// abstract names may contain null characters, paths can't.
+	if (!abstract && (path.find('\0') != std::string_view::npos))
+		throw std::invalid_argument(ERR_PATH_CONTAINS_NULL.data());
+
+	this->m_path = path;
+	this->m_abstract = (abstract && !path.empty());
+	this->UpdateNativeSocketAddress();
+
+}
+
+const void* UnixSocketAddress::GetNativeSocketAddress() const {
+	return this->m_sockaddr.data();
+}
+
+std::int32_t UnixSocketAddress::GetNativeSocketAddressLength() const {
+	return this->m_sockaddrLen;
+}
+
+void UnixSocketAddress::SetNativeSocketAddress(const void* sockaddr, const std::int32_t length) {
+
+	const struct sockaddr_un* source = reinterpret_cast<const struct sockaddr_un*>(sockaddr);
+
+	if ((source == nullptr) || (length < 0) || (length > static_cast<std::int32_t>(sizeof(struct sockaddr_un))))
+		throw std::invalid_argument(ERR_BAD_NATIVE_SOCKADDR.data());
+
+	// recvfrom reports a zero length address for datagrams from unnamed sockets.
+	if ((length >= static_cast<std::int32_t>(SUN_PATH_OFFSET)) && (source->sun_family != AF_UNIX))
+		throw std::invalid_argument(ERR_BAD_NATIVE_SOCKADDR.data());
+
+	const std::size_t pathLen = ((length > static_cast<std::int32_t>(SUN_PATH_OFFSET)) ? (static_cast<std::size_t>(length) - SUN_PATH_OFFSET) : 0);
+
+	// an abstract name starts with a null character and is not null-terminated.
+	if ((pathLen > 0) && (source->sun_path[0] == '\0')) {
+		this->m_path.assign((source->sun_path + 1), (pathLen - 1));
+		this->m_abstract = true;
+	}
+	else {
+		this->m_path.assign(source->sun_path, strnlen(source->sun_path, pathLen));
+		this->m_abstract = false;
+	}
+
+	this->UpdateNativeSocketAddress();
+
+}
+
+// builds the native sockaddr_un once, so sockets can use it as is.
+void UnixSocketAddress::UpdateNativeSocketAddress() {
+
+	this->m_sockaddr.fill(0);
+
+	struct sockaddr_un* sockaddr = reinterpret_cast<struct sockaddr_un*>(this->m_sockaddr.data());
+	sockaddr->sun_family = AF_UNIX;
+
+	if (this->m_abstract) {
+		std::memcpy((sockaddr->sun_path + 1), this->m_path.data(), this->m_path.size());
+		this->m_sockaddrLen = static_cast<std::int32_t>(SUN_PATH_OFFSET + 1 + this->m_path.size());
+	}
+	else if (!this->m_path.empty()) {
+		std::memcpy(sockaddr->sun_path, this->m_path.data(), this->m_path.size());
+		this->m_sockaddrLen = static_cast<std::int32_t>(SUN_PATH_OFFSET + this->m_path.size() + 1);
+	}
+	else this->m_sockaddrLen = static_cast<std::int32_t>(SUN_PATH_OFFSET);
+
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include <Vnetworking/Sockets/WriteQueue.h>
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using namespace Vnetworking::Sockets;
+
+constexpr std::string_view ERR_BAD_WATERMARKS = "'lowWatermark' is greater than 'highWatermark'.";
+
+// small writes are copied into chunks of this size, so that many of them go out in one buffer.
+constexpr std::size_t CHUNK_SIZE = 16384;
+
+// the maximum number of chunks passed to one vectored send.
+constexpr std::size_t MAX_CHUNKS_PER_SEND = 64;
+
+WriteQueue::WriteQueue(const Socket& socket, const std::size_t lowWatermark, const std::size_t highWatermark, const BackpressureHandler& handler)
+	: m_socket(&socket), m_lowWatermark(lowWatermark), m_highWatermark(highWatermark), m_handler(handler), m_offset(0), m_queued(0), m_paused(false) {
+
+	if (lowWatermark > highWatermark)
+		throw std::invalid_argument(ERR_BAD_WATERMARKS.data());
+
+}
+
+WriteQueue::WriteQueue(const Socket& socket, const std::size_t lowWatermark, const std::size_t highWatermark)
+	: WriteQueue(socket, lowWatermark, highWatermark, nullptr) { }
+
+WriteQueue::~WriteQueue() { }
+
+const Socket& WriteQueue::GetSocket() const {
+	return *this->m_socket;
+}
+
+std::size_t WriteQueue::GetQueuedSize() const {
+	return this->m_queued;
+}
+
+std::size_t WriteQueue::GetLowWatermark() const {
+	return this->m_lowWatermark;
+}
+
+std::size_t WriteQueue::GetHighWatermark() const {
+	return this->m_highWatermark;
+}
+
+bool WriteQueue::IsEmpty() const {
+	return (this->m_queued == 0);
+}
+
+bool WriteQueue::IsPaused() const {
+	return this->m_paused;
+}
+
+void WriteQueue::Write(const std::span<const std::uint8_t>& data) {
+
+	if (data.empty()) return;
+
+	// append to the last chunk if there's room left in it, otherwise start a new one.
+	// data that is larger than a chunk gets a chunk of its own.
+	if (!this->m_chunks.empty() && ((this->m_chunks.back().capacity() - this->m_chunks.back().size()) >= data.size()))
+		this->m_chunks.back().insert(this->m_chunks.back().end(), data.begin(), data.end());
+	else if (data.size() < CHUNK_SIZE) {
+		std::vector<std::uint8_t>& chunk = this->m_chunks.emplace_back();
+		chunk.reserve(CHUNK_SIZE);
+		chunk.insert(chunk.end(), data.begin(), data.end());
+	}
+	else this->m_chunks.emplace_back(data.begin(), data.end());
+
+	this->OnQueued(data.size());
+
+}
+
+// queues the data without copying it, unless it's small enough to be coalesced.
+void WriteQueue::Write(std::vector<std::uint8_t>&& data) {
+
+	if (data.size() < CHUNK_SIZE) {
+		this->Write(std::span<const std::uint8_t>(data));
+		return;
+	}
+
+	const std::size_t size = data.size();
+	this->m_chunks.push_back(std::move(data));
+	this->OnQueued(size);
+
+}
+
+// sends queued data until the queue is empty or the socket would block.
+// Bytes is the number of bytes sent, even if the flush stopped because of an error.
+// WouldBlock is true if data is left in the queue because the socket's send buffer is full:
+// the queue should be flushed again once the socket becomes writable.
+// if the socket's rate limiter held the data back, RetryDelay is set as well. the socket may still be writable,
+// so no new writable event will come: the caller must schedule the next flush on a timer, after RetryDelay milliseconds.
+SocketResult WriteQueue::Flush() {
+
+	std::size_t total = 0;
+
+	while (!this->m_chunks.empty()) {
+
+		std::span<const std::uint8_t> buffers[MAX_CHUNKS_PER_SEND];
+		std::size_t count = 0;
+		std::size_t size = 0;
+
+		for (auto it = this->m_chunks.begin(); (it != this->m_chunks.end()) && (count < MAX_CHUNKS_PER_SEND); ++it) {
+			const std::size_t skip = ((count == 0) ? this->m_offset : 0);
+			buffers[count++] = std::span<const std::uint8_t>((it->data() + skip), (it->size() - skip));
+			size += (it->size() - skip);
+		}
+
+		const SocketResult result = this->m_socket->TrySendV(std::span<const std::span<const std::uint8_t>>(buffers, count));
+		if (result.ErrorCode != 0)
+			return { static_cast<std::int32_t>(std::min<std::size_t>(total, INT32_MAX)), result.ErrorCode, result.WouldBlock, result.RetryDelay };
+
+		total += static_cast<std::size_t>(result.Bytes);
+		this->OnSent(static_cast<std::size_t>(result.Bytes));
+
+		// the kernel took only part of the data, so its send buffer is full.
+		if (static_cast<std::size_t>(result.Bytes) < size)
+			return { static_cast<std::int32_t>(std::min<std::size_t>(total, INT32_MAX)), 0, true, 0 };
+
+	}
+
+	return { static_cast<std::int32_t>(std::min<std::size_t>(total, INT32_MAX)), 0, false, 0 };
+}
+
+// discards all queued data, e.g. when the connection is closed.
+void WriteQueue::Clear() {
+
+	this->m_chunks.clear();
+	this->m_offset = 0;
+	this->OnSent(this->m_queued);
+
+}
+
+void WriteQueue::OnQueued(const std::size_t size) {
+
+	this->m_queued += size;
+
+	if (!this->m_paused && (this->m_queued >= this->m_highWatermark)) {
+		this->m_paused = true;
+		if (this->m_handler) this->m_handler(true);
+	}
+
+}
+
+void WriteQueue::OnSent(std::size_t size) {
+
+	this->m_queued -= size;
+
+	// drop the chunks that were sent completely.
+	while ((size > 0) && !this->m_chunks.empty()) {
+
+		const std::size_t remaining = (this->m_chunks.front().size() - this->m_offset);
+		if (size < remaining) {
+			this->m_offset += size;
+			break;
+		}
+
+		size -= remaining;
+		this->m_chunks.pop_front();
+		this->m_offset = 0;
+
+	}
+
+	if (this->m_paused && (this->m_queued <= this->m_lowWatermark)) {
+		this->m_paused = false;
+		if (this->m_handler) this->m_handler(false);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,271 @@
+#include <Vnetworking/TimerWheel.h>
+
+#include <bit>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+
+using namespace Vnetworking;
+
+typedef std::chrono::steady_clock Clock;
+
+constexpr std::string_view ERR_BAD_RESOLUTION = "'resolution' is less than or equal to zero.";
+constexpr std::string_view ERR_TIMEOUT_LESS_THAN_ZERO = "'timeout' is less than zero.";
+constexpr std::string_view ERR_BAD_CALLBACK = "'callback' is empty.";
+
+constexpr std::uint32_t NO_TIMER = 0xFFFFFFFF;
+constexpr std::uint32_t SLOT_BITS = 8;
+constexpr std::uint64_t SLOT_MASK = 0xFF;
+
+// the furthest a timer can be scheduled (the span of all levels). longer timeouts are clamped to this, so such timers fire early.
+// a timeout is at most INT32_MAX milliseconds, so with any resolution this is only reached in theory.
+constexpr std::uint64_t MAX_TIMEOUT_TICKS = 0xFFFFFFFF;
+
+TimerWheel::TimerWheel() : TimerWheel(1) { }
+
+TimerWheel::TimerWheel(const std::int32_t resolution) {
+
+	if (resolution <= 0)
+		throw std::out_of_range(ERR_BAD_RESOLUTION.data());
+
+	this->m_resolution = resolution;
+	this->m_start = Clock::now();
+	this->m_currentTick = 0;
+
+	this->m_freeList = NO_TIMER;
+	this->m_activeCount = 0;
+
+	this->m_slots.fill(NO_TIMER);
+	for (auto& level : this->m_occupied) level.fill(0);
+
+}
+
+TimerWheel::~TimerWheel() { }
+
+std::int32_t TimerWheel::GetResolution() const {
+	return this->m_resolution;
+}
+
+std::size_t TimerWheel::GetTimerCount() const {
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	return this->m_activeCount;
+}
+
+std::uint64_t TimerWheel::GetElapsedTicks() const {
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - this->m_start);
+	return static_cast<std::uint64_t>(elapsed.count() / this->m_resolution);
+}
+
+void TimerWheel::Link(const std::uint32_t index) {
+
+	Timer& timer = this->m_timers[index];
+	const std::uint64_t delta = ((timer.Expires > this->m_currentTick) ? (timer.Expires - this->m_currentTick) : 0);
+
+	// pick the finest level that can hold the timer without wrapping around.
+	std::size_t level = 0;
+	while ((level < (LEVELS - 1)) && (delta >= (1ull << (SLOT_BITS * (level + 1))))) ++level;
+
+	const std::size_t slot = ((timer.Expires >> (SLOT_BITS * level)) & SLOT_MASK);
+	timer.Slot = static_cast<std::uint16_t>((level * SLOTS_PER_LEVEL) + slot);
+
+	timer.Prev = NO_TIMER;
+	timer.Next = this->m_slots[timer.Slot];
+	if (timer.Next != NO_TIMER) this->m_timers[timer.Next].Prev = index;
+
+	this->m_slots[timer.Slot] = index;
+	this->m_occupied[level][slot / 64] |= (1ull << (slot % 64));
+
+}
+
+void TimerWheel::Unlink(const std::uint32_t index) {
+
+	Timer& timer = this->m_timers[index];
+
+	if (timer.Prev != NO_TIMER) this->m_timers[timer.Prev].Next = timer.Next;
+	else this->m_slots[timer.Slot] = timer.Next;
+
+	if (timer.Next != NO_TIMER) this->m_timers[timer.Next].Prev = timer.Prev;
+
+	if (this->m_slots[timer.Slot] == NO_TIMER) {
+		const std::size_t level = (timer.Slot / SLOTS_PER_LEVEL);
+		const std::size_t slot = (timer.Slot % SLOTS_PER_LEVEL);
+		this->m_occupied[level][slot / 64] &= ~(1ull << (slot % 64));
+	}
+
+}
+
+void TimerWheel::Release(const std::uint32_t index) {
+
+	Timer& timer = this->m_timers[index];
+	timer.Active = false;
+	timer.Callback = nullptr;
+
+	// bumping the generation invalidates TimerIds that still refer to this entry.
+	if (++timer.Generation == 0) timer.Generation = 1;
+
+	timer.Next = this->m_freeList;
+	this->m_freeList = index;
+	--this->m_activeCount;
+
+}
+
+void TimerWheel::Cascade(const std::size_t level, const std::size_t slot) {
+
+	const std::size_t slotIndex = ((level * SLOTS_PER_LEVEL) + slot);
+
+	// detach the whole list first, since timers may be filed back into the same slot.
+	std::uint32_t index = this->m_slots[slotIndex];
+	this->m_slots[slotIndex] = NO_TIMER;
+	this->m_occupied[level][slot / 64] &= ~(1ull << (slot % 64));
+
+	while (index != NO_TIMER) {
+		const std::uint32_t next = this->m_timers[index].Next;
+		this->Link(index);
+		index = next;
+	}
+
+}
+
+void TimerWheel::CollectExpired(std::vector<std::function<void(void)>>& callbacks) {
+
+	const std::uint64_t target = this->GetElapsedTicks();
+
+	while (this->m_currentTick < target) {
+
+		if (this->m_activeCount == 0) {
+			this->m_currentTick = target;
+			break;
+		}
+
+		++this->m_currentTick;
+
+		// when the first level wraps around, the next slot of the level above is moved down.
+		if ((this->m_currentTick & SLOT_MASK) == 0) {
+			for (std::size_t level = 1; level < LEVELS; ++level) {
+				const std::size_t slot = ((this->m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK);
+				this->Cascade(level, slot);
+				if (slot != 0) break;
+			}
+		}
+
+		const std::size_t slot = (this->m_currentTick & SLOT_MASK);
+		
+		std::uint32_t index = this->m_slots[slot];
+		this->m_slots[slot] = NO_TIMER;
+		this->m_occupied[0][slot / 64] &= ~(1ull << (slot % 64));
+
+		while (index != NO_TIMER) {
+			const std::uint32_t next = this->m_timers[index].Next;
+			callbacks.push_back(std::move(this->m_timers[index].Callback));
+			this->Release(index);
+			index = next;
+		}
+
+	}
+
+}
+
+std::int32_t TimerWheel::GetNextTimeout() const {
+
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+	if (this->m_activeCount == 0) return -1;
+
+	// look for the next occupied slot in the first level. if there is none before the level wraps
+	// around, wake up at the wrap-around, when the next batch of timers is moved down.
+	const std::size_t position = (this->m_currentTick & SLOT_MASK);
+	std::uint64_t ticksAhead = (SLOTS_PER_LEVEL - position);
+
+	for (std::size_t slot = (position + 1); slot < SLOTS_PER_LEVEL;) {
+
+		const std::uint64_t bits = (this->m_occupied[0][slot / 64] >> (slot % 64));
+		if (bits != 0) {
+			ticksAhead = ((slot + std::countr_zero(bits)) - position);
+			break;
+		}
+
+		slot = (((slot / 64) + 1) * 64);
+
+	}
+
+	const Clock::time_point due = (this->m_start + std::chrono::milliseconds((this->m_currentTick + ticksAhead) * this->m_resolution));
+	const auto timeout = std::chrono::ceil<std::chrono::milliseconds>(due - Clock::now()).count();
+
+	return static_cast<std::int32_t>(std::clamp<std::int64_t>(timeout, 0, INT32_MAX));
+}
+
+TimerId TimerWheel::Schedule(const std::int32_t timeout, std::function<void(void)> callback) {
+
+	if (timeout < 0)
+		throw std::out_of_range(ERR_TIMEOUT_LESS_THAN_ZERO.data());
+
+	if (!callback)
+		throw std::invalid_argument(ERR_BAD_CALLBACK.data());
+
+	// round up, and count from the start of the next tick, so that timers never fire early.
+	const std::uint64_t ticks = std::min<std::uint64_t>((((timeout + this->m_resolution) - 1) / this->m_resolution) + 1, MAX_TIMEOUT_TICKS);
+	const std::uint64_t now = this->GetElapsedTicks();
+
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	std::uint32_t index = this->m_freeList;
+	if (index != NO_TIMER) this->m_freeList = this->m_timers[index].Next;
+	else {
+		index = static_cast<std::uint32_t>(this->m_timers.size());
+		this->m_timers.push_back({ 0, nullptr, NO_TIMER, NO_TIMER, 1, 0, false });
+	}
+
+	Timer& timer = this->m_timers[index];
+	timer.Expires = (std::max(now, this->m_currentTick) + ticks);
+	timer.Callback = std::move(callback);
+	timer.Active = true;
+
+	this->Link(index);
+	++this->m_activeCount;
+
+	return ((static_cast<TimerId>(timer.Generation) << 32) | index);
+}
+
+bool TimerWheel::Cancel(const TimerId timer) {
+
+	const std::uint32_t index = static_cast<std::uint32_t>(timer & 0xFFFFFFFF);
+	const std::uint32_t generation = static_cast<std::uint32_t>(timer >> 32);
+
+	const std::lock_guard<std::mutex> lock(this->m_mutex);
+
+	if (index >= this->m_timers.size()) return false;
+	if (!this->m_timers[index].Active || (this->m_timers[index].Generation != generation)) return false;
+
+	this->Unlink(index);
+	this->Release(index);
+
+	return true;
+}
+
+std::int32_t TimerWheel::Advance() {
+
+	std::vector<std::function<void(void)>> callbacks;
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->CollectExpired(callbacks);
+	}
+
+	// callbacks run without the lock held, so they can schedule and cancel timers.
+	for (const std::function<void(void)>& callback : callbacks)
+		callback();
+
+	return static_cast<std::int32_t>(callbacks.size());
+}
+
+std::int32_t TimerWheel::Advance(ThreadPool<>& threadPool) {
+
+	std::vector<std::function<void(void)>> callbacks;
+	{
+		const std::lock_guard<std::mutex> lock(this->m_mutex);
+		this->CollectExpired(callbacks);
+	}
+
+	for (const std::function<void(void)>& callback : callbacks)
+		threadPool.EnqueueJob(callback);
+
+	return static_cast<std::int32_t>(callbacks.size());
+}
\ No newline at end of file
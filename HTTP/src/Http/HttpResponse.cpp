@@ -212,7 +212,7 @@ HttpResponse HttpResponse::Parse(const std::span<const std::uint8_t>& data) {
 	return httpResponse;
 }
 
-std::vector<std::uint8_t> HttpResponse::Serialize(const HttpResponse& httpResponse) {
+std::vector<std::uint8_t> HttpResponse::SerializeHeaders(const HttpResponse& httpResponse) {
 
 	std::ostringstream stream;
 
@@ -254,13 +254,20 @@ std::vector<std::uint8_t> HttpResponse::Serialize(const HttpResponse& httpRespon
 
 	stream << "\r\n";
 
-	// serialize the payload:
-	for (const std::uint8_t byte : httpResponse.GetPayload())
-		stream << static_cast<char>(byte);
-
 	const std::string str = { stream.str() };
 	std::vector<std::uint8_t> data(str.length());
 	memcpy_s(data.data(), data.size(), str.c_str(), str.length());
 
+	return data;
+}
+
+std::vector<std::uint8_t> HttpResponse::Serialize(const HttpResponse& httpResponse) {
+
+	std::vector<std::uint8_t> data = HttpResponse::SerializeHeaders(httpResponse);
+
+	// serialize the payload:
+	const std::vector<std::uint8_t>& payload = httpResponse.GetPayload();
+	data.insert(data.end(), payload.begin(), payload.end());
+
 	return data;
 }
\ No newline at end of file
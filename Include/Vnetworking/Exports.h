@@ -6,25 +6,37 @@
 #ifndef _NE_EXPORTS_H_
 #define _NE_EXPORTS_H_
 
+#include <Vnetworking/Platform.h>
+
+#ifdef NE_PLATFORM_WINDOWS
+#define NE_EXPORT __declspec(dllexport)
+#define NE_IMPORT __declspec(dllimport)
+#else
+#define NE_EXPORT __attribute__((visibility("default")))
+#define NE_IMPORT __attribute__((visibility("default")))
+#endif
+
 #ifdef NE_BUILD_CORE_DLL
-#define VNETCOREAPI __declspec(dllexport)
+#define VNETCOREAPI NE_EXPORT
 #else
-#define VNETCOREAPI __declspec(dllimport)
+#define VNETCOREAPI NE_IMPORT
 #endif
 
 #ifdef NE_BUILD_HTTP_DLL
-#define VNETHTTPAPI __declspec(dllexport)
+#define VNETHTTPAPI NE_EXPORT
 #else
-#define VNETHTTPAPI __declspec(dllimport)
+#define VNETHTTPAPI NE_IMPORT
 #endif
 
 #ifdef NE_BUILD_SECURITY_DLL
-#define VNETSECURITYAPI __declspec(dllexport)
+#define VNETSECURITYAPI NE_EXPORT
 #else
-#define VNETSECURITYAPI __declspec(dllimport)
+#define VNETSECURITYAPI NE_IMPORT
 #endif
 
+#ifdef _MSC_VER
 #pragma warning (disable: 4251)
 #pragma warning (disable: 4275)
+#endif
 
 #endif // _NE_EXPORTS_H_
\ No newline at end of file
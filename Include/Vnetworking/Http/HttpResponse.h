@@ -53,6 +53,10 @@ namespace Vnetworking::Http {
 
 		static HttpResponse Parse(const std::span<const std::uint8_t>& data);
 		static std::vector<std::uint8_t> Serialize(const HttpResponse& httpResponse);
+		
+		// serializes the status line and the headers, without the payload.
+		// the result and GetPayload() can be sent together with Socket::SendV, without copying the payload.
+		static std::vector<std::uint8_t> SerializeHeaders(const HttpResponse& httpResponse);
 
 	};
 
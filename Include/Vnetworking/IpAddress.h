@@ -41,6 +41,7 @@ namespace Vnetworking {
 
 		bool IsPublicAddress(void) const;
 		bool IsPrivateAddress(void) const;
+		bool IsMulticastAddress(void) const;
 
 		static inline IpAddress Any(void) noexcept { return { 0, 0, 0, 0, }; };
 		static inline IpAddress Localhost(void) noexcept { return { 127, 0, 0, 1, }; };
@@ -11,7 +11,7 @@
 #elif defined(__APPLE__) || defined(__MACH__)
 #error "Vnetworking: Cannot build: macOS is not supported."
 #elif defined(__linux__)
-#error "Vnetworking: Cannot build: Linux is not supported."
+#define NE_PLATFORM_LINUX
 #else
 #error "Vnetworking: Cannot build: unknown platform."
 #endif
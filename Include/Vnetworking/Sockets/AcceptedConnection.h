@@ -0,0 +1,25 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_ACCEPTEDCONNECTION_H_
+#define _NE_ACCEPTEDCONNECTION_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/Sockets/Socket.h>
+#include <Vnetworking/Sockets/IpSocketAddress.h>
+
+#include <optional>
+
+namespace Vnetworking::Sockets {
+
+	// describes a connection filled in by Socket::AcceptMany.
+	typedef struct AcceptedConnection {
+		std::optional<Socket> Client; // the accepted (non-blocking) socket.
+		IpSocketAddress Address; // the address of the peer.
+	} AcceptedConnection;
+
+}
+
+#endif // _NE_ACCEPTEDCONNECTION_H_
\ No newline at end of file
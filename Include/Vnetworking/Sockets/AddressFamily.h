@@ -17,6 +17,7 @@ namespace Vnetworking::Sockets {
 		UNSPECIFIED,
 		IPV4,
 		IPV6,
+		UNIX,
 	
 	};
 
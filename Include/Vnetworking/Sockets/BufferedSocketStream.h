@@ -0,0 +1,71 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_BUFFEREDSOCKETSTREAM_H_
+#define _NE_BUFFEREDSOCKETSTREAM_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/Platform.h>
+#include <Vnetworking/Sockets/Socket.h>
+#include <Vnetworking/Sockets/SocketResult.h>
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace Vnetworking::Sockets {
+
+	// BufferedSocketStream reads from a socket in large chunks into a power-of-two ring buffer,
+	// and hands out the buffered data as contiguous spans, without copying it.
+	// on Linux, the ring is mapped twice back to back, so data that wraps around the end of the ring
+	// is still contiguous. elsewhere (or if mirrored is false), the data is moved to the front of the
+	// buffer instead, when the end is reached.
+	// spans returned by Peek, ReadUntil and ReadExact stay valid until the next call that reads from the socket.
+	// the socket must outlive the stream.
+	class VNETCOREAPI BufferedSocketStream {
+
+	private:
+		const Socket* m_socket;
+
+		std::uint8_t* m_buffer;
+		std::size_t m_capacity;
+		bool m_mirrored;
+
+		std::size_t m_readPos;
+		std::size_t m_writePos;
+
+	public:
+		BufferedSocketStream(const Socket& socket);
+		BufferedSocketStream(const Socket& socket, const std::size_t capacity);
+		BufferedSocketStream(const Socket& socket, const std::size_t capacity, const bool mirrored);
+		BufferedSocketStream(const BufferedSocketStream&) = delete;
+		BufferedSocketStream(BufferedSocketStream&&) noexcept = delete;
+		virtual ~BufferedSocketStream(void);
+
+		BufferedSocketStream& operator= (const BufferedSocketStream&) = delete;
+		BufferedSocketStream& operator= (BufferedSocketStream&&) noexcept = delete;
+
+		const Socket& GetSocket(void) const;
+		std::size_t GetCapacity(void) const;
+		std::size_t GetBufferedSize(void) const;
+		bool IsMirrored(void) const;
+
+		std::int32_t Fill(void);
+		SocketResult TryFill(void) noexcept;
+
+		std::span<const std::uint8_t> Peek(void) const;
+		std::span<const std::uint8_t> ReadUntil(const std::string_view delimiter);
+		std::span<const std::uint8_t> ReadExact(const std::size_t size);
+		void Consume(const std::size_t size);
+
+	private:
+		std::span<std::uint8_t> GetWritableSpan(void) noexcept;
+		void Commit(const std::size_t size) noexcept;
+
+	};
+
+}
+
+#endif // _NE_BUFFEREDSOCKETSTREAM_H_
\ No newline at end of file
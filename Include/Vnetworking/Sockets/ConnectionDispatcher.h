@@ -0,0 +1,76 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_CONNECTIONDISPATCHER_H_
+#define _NE_CONNECTIONDISPATCHER_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/Sockets/Socket.h>
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+
+namespace Vnetworking::Sockets {
+
+	// ConnectionDispatcher hands accepted connections to a group of worker threads, each pinned to one CPU.
+	// a connection goes to the worker of the CPU that received its packets (see Socket::GetIncomingCpu),
+	// so the kernel's protocol processing and the application's work on the connection share one core's caches.
+	// worker i is pinned to CPU (i % number of CPUs), so with fewer workers than CPUs, some CPUs have no worker:
+	// connections received on those CPUs, or whose CPU is unknown, are spread across the workers in turn.
+	class VNETCOREAPI ConnectionDispatcher {
+
+	public:
+		// called on the worker thread the connection was dispatched to.
+		using ConnectionHandler = std::function<void(const std::int32_t worker, Socket socket)>;
+
+	private:
+		typedef struct {
+			std::deque<Socket> Connections;
+			std::mutex Mutex;
+			std::condition_variable Condition;
+		} WorkerQueue;
+
+		std::int32_t m_workerCount;
+		std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+		std::vector<std::uint32_t> m_workerCpus;
+		std::vector<std::vector<std::int32_t>> m_cpuWorkers;
+		std::vector<std::thread> m_workers;
+		std::atomic<std::uint32_t> m_nextWorker;
+		std::atomic<bool> m_running;
+
+	public:
+		ConnectionDispatcher(const std::int32_t workerCount);
+		ConnectionDispatcher(void);
+		ConnectionDispatcher(const ConnectionDispatcher&) = delete;
+		ConnectionDispatcher(ConnectionDispatcher&&) noexcept = delete;
+		virtual ~ConnectionDispatcher(void);
+
+		ConnectionDispatcher& operator= (const ConnectionDispatcher&) = delete;
+		ConnectionDispatcher& operator= (ConnectionDispatcher&&) noexcept = delete;
+
+		std::int32_t GetWorkerCount(void) const;
+		std::uint32_t GetWorkerCpu(const std::int32_t worker) const;
+
+		void Start(const ConnectionHandler& handler);
+		void Stop(void);
+
+		std::int32_t Dispatch(Socket&& socket);
+		void Dispatch(const std::int32_t worker, Socket&& socket);
+
+	private:
+		void WorkerThreadProc(const std::int32_t worker, const ConnectionHandler handler);
+
+	};
+
+}
+
+#endif // _NE_CONNECTIONDISPATCHER_H_
\ No newline at end of file
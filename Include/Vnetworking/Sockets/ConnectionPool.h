@@ -0,0 +1,79 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_CONNECTIONPOOL_H_
+#define _NE_CONNECTIONPOOL_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/IpAddress.h>
+#include <Vnetworking/Sockets/Socket.h>
+#include <Vnetworking/Sockets/IpSocketAddress.h>
+#include <Vnetworking/Sockets/Connector.h>
+#include <Vnetworking/Sockets/ConnectionPoolStatistics.h>
+
+#include <cstdint>
+#include <string>
+#include <deque>
+#include <optional>
+#include <chrono>
+#include <mutex>
+#include <unordered_map>
+
+namespace Vnetworking::Sockets {
+
+	// ConnectionPool keeps idle outbound TCP connections, so they can be reused instead of reconnecting.
+	// connections are taken out with Acquire and handed back with Release once the exchange on them is
+	// complete; a released connection must not have any unread data pending.
+	// idle connections are reused most-recently-released first, and are checked before they are handed out:
+	// a connection that timed out, or that became readable (closed by the peer) is closed instead.
+	class VNETCOREAPI ConnectionPool {
+
+	private:
+		typedef struct {
+			Socket Connection;
+			std::chrono::steady_clock::time_point ReleaseTime;
+		} IdleConnection;
+
+		std::int32_t m_maxIdle;
+		std::int32_t m_maxIdlePerHost;
+		std::int32_t m_idleTimeout;
+		Connector m_connector;
+
+		std::unordered_map<std::string, std::deque<IdleConnection>> m_connections;
+		std::int32_t m_idleCount;
+		ConnectionPoolStatistics m_statistics;
+		mutable std::mutex m_mutex;
+
+	public:
+		ConnectionPool(void);
+		ConnectionPool(const std::int32_t maxIdle, const std::int32_t maxIdlePerHost, const std::int32_t idleTimeout);
+		ConnectionPool(const std::int32_t maxIdle, const std::int32_t maxIdlePerHost, const std::int32_t idleTimeout, const Connector& connector);
+		ConnectionPool(const ConnectionPool&) = delete;
+		ConnectionPool(ConnectionPool&&) noexcept = delete;
+		virtual ~ConnectionPool(void);
+
+		ConnectionPool& operator= (const ConnectionPool&) = delete;
+		ConnectionPool& operator= (ConnectionPool&&) noexcept = delete;
+
+		Socket Acquire(const IpSocketAddress& endpoint);
+		Socket Acquire(const std::string& hostname, const Port port);
+		void Release(const IpSocketAddress& endpoint, Socket&& connection);
+		void Release(const std::string& hostname, const Port port, Socket&& connection);
+
+		void Prune(void);
+		void Clear(void);
+
+		std::int32_t GetIdleCount(void) const;
+		ConnectionPoolStatistics GetStatistics(void) const;
+
+	private:
+		std::optional<Socket> TakeIdleConnection(const std::string& key);
+		void ReturnIdleConnection(const std::string& key, Socket&& connection);
+
+	};
+
+}
+
+#endif // _NE_CONNECTIONPOOL_H_
\ No newline at end of file
@@ -0,0 +1,24 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_CONNECTIONPOOLSTATISTICS_H_
+#define _NE_CONNECTIONPOOLSTATISTICS_H_
+
+#include <Vnetworking/Exports.h>
+
+#include <cstdint>
+
+namespace Vnetworking::Sockets {
+
+	typedef struct {
+		std::uint64_t Hits; // acquisitions served by an idle connection.
+		std::uint64_t Misses; // acquisitions that had to open a new connection.
+		std::uint64_t Expired; // idle connections closed because they timed out or were no longer alive.
+		std::uint64_t Discarded; // released connections closed because the pool was full.
+	} ConnectionPoolStatistics;
+
+}
+
+#endif // _NE_CONNECTIONPOOLSTATISTICS_H_
\ No newline at end of file
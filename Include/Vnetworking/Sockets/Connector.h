@@ -0,0 +1,52 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_CONNECTOR_H_
+#define _NE_CONNECTOR_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/IpAddress.h>
+#include <Vnetworking/Dns/DnsLookupResult.h>
+#include <Vnetworking/Sockets/Socket.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Vnetworking::Sockets {
+
+	// Connector opens TCP connections to hosts with several addresses using Happy Eyeballs (RFC 8305).
+	// connection attempts are started one after another, alternating between IPv6 and IPv4, each
+	// one a connection attempt delay after the previous one, without waiting for earlier attempts to fail.
+	// the first attempt that succeeds wins, and the rest are abandoned.
+	class VNETCOREAPI Connector {
+
+	private:
+		std::int32_t m_attemptDelay;
+		std::int32_t m_timeout;
+
+	public:
+		Connector(void);
+		Connector(const std::int32_t attemptDelay, const std::int32_t timeout);
+		Connector(const Connector& connector);
+		virtual ~Connector(void);
+
+		Connector& operator= (const Connector& connector);
+
+		std::int32_t GetConnectionAttemptDelay(void) const;
+		std::int32_t GetTimeout(void) const;
+
+		void SetConnectionAttemptDelay(const std::int32_t attemptDelay);
+		void SetTimeout(const std::int32_t timeout);
+
+		Socket Connect(const std::vector<IpAddress>& addresses, const Port port) const;
+		Socket Connect(const Dns::DnsLookupResult& lookupResult, const Port port) const;
+		Socket Connect(const std::string& hostname, const Port port) const;
+
+	};
+
+}
+
+#endif // _NE_CONNECTOR_H_
\ No newline at end of file
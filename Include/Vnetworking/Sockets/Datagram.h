@@ -0,0 +1,34 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_DATAGRAM_H_
+#define _NE_DATAGRAM_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/Sockets/IpSocketAddress.h>
+
+#include <cstdint>
+#include <span>
+
+namespace Vnetworking::Sockets {
+
+	// describes a datagram passed to Socket::SendToBatch.
+	typedef struct {
+		std::span<const std::uint8_t> Buffer;
+		std::int32_t Size; // the number of bytes from Buffer to send.
+		IpSocketAddress Address; // the destination.
+	} OutgoingDatagram;
+
+	// describes a datagram filled in by Socket::ReceiveFromBatch.
+	typedef struct {
+		std::span<std::uint8_t> Buffer;
+		std::int32_t Size; // the number of bytes received.
+		IpSocketAddress Address; // the sender.
+		bool Truncated; // true if the datagram was larger than Buffer.
+	} IncomingDatagram;
+
+}
+
+#endif // _NE_DATAGRAM_H_
\ No newline at end of file
@@ -0,0 +1,68 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_EVENTLOOP_H_
+#define _NE_EVENTLOOP_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/Platform.h>
+#include <Vnetworking/Sockets/Socket.h>
+#include <Vnetworking/Sockets/PollEvents.h>
+#include <Vnetworking/TimerWheel.h>
+
+#include <cstdint>
+#include <span>
+
+#ifdef NE_PLATFORM_WINDOWS
+#include <unordered_map>
+#include <utility>
+#include <mutex>
+#endif
+
+namespace Vnetworking::Sockets {
+
+	typedef struct {
+		PollEvents Events;
+		std::uint64_t UserData;
+	} SocketEvent;
+
+	// EventLoop waits for readiness events on many sockets at once.
+	// on Linux, sockets are registered with epoll in edge-triggered mode: an event is reported
+	// only when the socket's state changes, so the socket should be non-blocking and
+	// read from/written to until the operation would block.
+	// on Windows, the event loop falls back to WSAPoll and events are level-triggered.
+	class VNETCOREAPI EventLoop {
+
+	private:
+#ifdef NE_PLATFORM_WINDOWS
+		std::unordered_map<NativeSocket_t, std::pair<PollEvents, std::uint64_t>> m_sockets;
+		mutable std::mutex m_mutex;
+#else
+		std::int32_t m_epoll;
+#endif
+
+	public:
+		EventLoop(void);
+		EventLoop(const EventLoop&) = delete;
+		EventLoop(EventLoop&&) noexcept = delete;
+		virtual ~EventLoop(void);
+
+		EventLoop& operator= (const EventLoop&) = delete;
+		EventLoop& operator= (EventLoop&&) noexcept = delete;
+
+		void Add(const Socket& socket, const PollEvents events, const std::uint64_t userData);
+		void Add(const Socket& socket, const PollEvents events);
+		void Modify(const Socket& socket, const PollEvents events, const std::uint64_t userData);
+		void Modify(const Socket& socket, const PollEvents events);
+		void Remove(const Socket& socket);
+
+		std::int32_t Wait(const std::span<SocketEvent>& events, const std::int32_t timeout) const;
+		std::int32_t Wait(const std::span<SocketEvent>& events, const std::int32_t timeout, TimerWheel& timers) const;
+
+	};
+
+}
+
+#endif // _NE_EVENTLOOP_H_
\ No newline at end of file
@@ -9,12 +9,19 @@
 #include <Vnetworking/Exports.h>
 #include <Vnetworking/Sockets/AddressFamily.h>
 
+#include <cstdint>
+
 namespace Vnetworking::Sockets {
 
 	class VNETCOREAPI ISocketAddress {
 	public:
 		virtual ~ISocketAddress(void) { };
 		virtual AddressFamily GetAddressFamily(void) const = 0;
+
+		// returns a pointer to the native sockaddr structure for this address, and its size in bytes.
+		// implementations are expected to keep the native address up to date, so sockets can use it as is.
+		virtual const void* GetNativeSocketAddress(void) const = 0;
+		virtual std::int32_t GetNativeSocketAddressLength(void) const = 0;
 	};
 
 }
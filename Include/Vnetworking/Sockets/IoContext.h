@@ -0,0 +1,107 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_IOCONTEXT_H_
+#define _NE_IOCONTEXT_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/Task.h>
+#include <Vnetworking/TimerWheel.h>
+#include <Vnetworking/Sockets/Socket.h>
+#include <Vnetworking/Sockets/PollEvents.h>
+#include <Vnetworking/Sockets/EventLoop.h>
+
+#include <cstdint>
+#include <coroutine>
+#include <unordered_map>
+#include <vector>
+
+namespace Vnetworking::Sockets {
+
+	// IoContext is a readiness reactor that drives coroutines (Socket::ReceiveAsync, Socket::SendAsync, ...).
+	// a coroutine that would block is suspended until its socket becomes ready, and is resumed from Run.
+	// a coroutine can also wait for a delay (e.g. a send held back by a rate limiter), see DelayAsync.
+	// an IoContext, and the coroutines running on it, must be used from one thread only.
+	class VNETCOREAPI IoContext {
+
+	public:
+		// suspends the awaiting coroutine until the socket is ready for the given events.
+		// if the wait is cancelled (see IoContext::Cancel), resuming throws a SocketException.
+		class VNETCOREAPI ReadinessAwaiter {
+
+			friend class IoContext;
+
+		private:
+			IoContext* m_context;
+			const Socket* m_socket;
+			PollEvents m_events;
+			std::coroutine_handle<> m_coroutine;
+			bool m_cancelled;
+
+		public:
+			ReadinessAwaiter(IoContext& context, const Socket& socket, const PollEvents events) noexcept;
+
+			bool await_ready(void) const noexcept;
+			void await_suspend(const std::coroutine_handle<> coroutine);
+			void await_resume(void) const;
+
+		};
+
+		// suspends the awaiting coroutine until a delay has passed.
+		class VNETCOREAPI DelayAwaiter {
+
+		private:
+			IoContext* m_context;
+			std::int32_t m_delay;
+
+		public:
+			DelayAwaiter(IoContext& context, const std::int32_t delay) noexcept;
+
+			bool await_ready(void) const noexcept;
+			void await_suspend(const std::coroutine_handle<> coroutine);
+			void await_resume(void) const noexcept;
+
+		};
+
+	private:
+		typedef struct {
+			const Socket* Target;
+			ReadinessAwaiter* Reader;
+			ReadinessAwaiter* Writer;
+		} Waiters;
+
+		EventLoop m_loop;
+		std::unordered_map<NativeSocket_t, Waiters> m_waiters;
+		TimerWheel m_timers;
+		std::vector<std::coroutine_handle<>> m_ready; // resumed by the next RunOnce (expired delays, cancelled waits).
+		bool m_stopped;
+
+	public:
+		IoContext(void);
+		IoContext(const IoContext&) = delete;
+		IoContext(IoContext&&) noexcept = delete;
+		virtual ~IoContext(void);
+
+		IoContext& operator= (const IoContext&) = delete;
+		IoContext& operator= (IoContext&&) noexcept = delete;
+
+		ReadinessAwaiter WaitAsync(const Socket& socket, const PollEvents events);
+		DelayAwaiter DelayAsync(const std::int32_t delay);
+		void Cancel(const Socket& socket);
+		void Spawn(Task<void>&& task);
+
+		std::int32_t RunOnce(const std::int32_t timeout);
+		void Run(void);
+		void Stop(void);
+
+	private:
+		void Suspend(ReadinessAwaiter& awaiter);
+		void SuspendFor(const std::int32_t delay, const std::coroutine_handle<> coroutine);
+
+	};
+
+}
+
+#endif // _NE_IOCONTEXT_H_
\ No newline at end of file
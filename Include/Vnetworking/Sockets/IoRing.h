@@ -0,0 +1,79 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_IORING_H_
+#define _NE_IORING_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/Platform.h>
+#include <Vnetworking/Sockets/Socket.h>
+#include <Vnetworking/Sockets/ISocketAddress.h>
+#include <Vnetworking/Sockets/SocketFlags.h>
+
+#ifdef NE_PLATFORM_LINUX
+
+#include <cstdint>
+#include <span>
+
+namespace Vnetworking::Sockets {
+
+	constexpr std::int32_t NO_BUFFER_ID = -1;
+
+	typedef struct {
+		std::uint64_t UserData;
+		std::int32_t Result; // bytes transferred, the accepted socket handle, or a negated error code (-errno).
+		std::int32_t BufferId; // the provided buffer that holds the received data, or NO_BUFFER_ID.
+		bool More; // true if a multishot operation will produce more completions.
+	} IoCompletion;
+
+	struct NativeIoRing;
+
+	// IoRing is an io_uring based submission/completion engine (Linux only).
+	// operations are queued without any system calls, and submitted in batches with Submit or SubmitAndWait.
+	// buffers passed to Send and Receive must stay valid until the operation's completion has been reaped.
+	// the userData of an in-flight Connect must be unique, since it's used to track the connect's address.
+	class VNETCOREAPI IoRing {
+
+	private:
+		NativeIoRing* m_ring;
+
+	public:
+		IoRing(void);
+		IoRing(const std::uint32_t entries);
+		IoRing(const IoRing&) = delete;
+		IoRing(IoRing&& ring) noexcept;
+		virtual ~IoRing(void);
+
+		IoRing& operator= (const IoRing&) = delete;
+		IoRing& operator= (IoRing&& ring) noexcept;
+
+		std::int32_t GetNativeHandle(void) const;
+
+		void Send(const Socket& socket, const std::span<const std::uint8_t>& data, const SocketFlags flags, const std::uint64_t userData);
+		void Receive(const Socket& socket, const std::span<std::uint8_t>& data, const SocketFlags flags, const std::uint64_t userData);
+		void ReceiveMultishot(const Socket& socket, const std::uint16_t bufferGroup, const std::uint64_t userData);
+		void Accept(const Socket& socket, const std::uint64_t userData);
+		void AcceptMultishot(const Socket& socket, const std::uint64_t userData);
+		void Connect(const Socket& socket, const ISocketAddress& sockaddr, const std::uint64_t userData);
+		void Cancel(const std::uint64_t target, const std::uint64_t userData);
+
+		void RegisterBufferGroup(const std::uint16_t bufferGroup, const std::uint32_t bufferCount, const std::uint32_t bufferSize);
+		void UnregisterBufferGroup(const std::uint16_t bufferGroup);
+		std::span<std::uint8_t> GetBuffer(const std::uint16_t bufferGroup, const std::int32_t bufferId) const;
+		void ReleaseBuffer(const std::uint16_t bufferGroup, const std::int32_t bufferId);
+
+		std::int32_t Submit(void);
+		std::int32_t SubmitAndWait(const std::uint32_t minCompletions);
+		std::int32_t GetCompletions(const std::span<IoCompletion>& completions);
+
+		Socket GetAcceptedSocket(const Socket& listener, const IoCompletion& completion) const;
+
+	};
+
+}
+
+#endif
+
+#endif // _NE_IORING_H_
\ No newline at end of file
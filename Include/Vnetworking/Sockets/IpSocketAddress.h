@@ -10,17 +10,28 @@
 #include <Vnetworking/IpAddress.h>
 #include <Vnetworking/Sockets/ISocketAddress.h>
 
+#include <cstdint>
+#include <array>
+
 namespace Vnetworking::Sockets {
 
+	// large enough to hold both sockaddr_in and sockaddr_in6.
+	constexpr std::size_t IP_NATIVE_SOCKADDR_SIZE = 32;
+
 	class VNETCOREAPI IpSocketAddress : public ISocketAddress {
 
 	private:
 		AddressFamily m_af;
 		IpAddress m_ipAddress;
 		Port m_port;
+		std::uint32_t m_scopeId;
+
+		alignas(std::uint64_t) std::array<std::uint8_t, IP_NATIVE_SOCKADDR_SIZE> m_sockaddr;
+		std::int32_t m_sockaddrLen;
 
 	public:
 		IpSocketAddress(void);
+		IpSocketAddress(const IpAddress& ipAddress, const Port port, const std::uint32_t scopeId);
 		IpSocketAddress(const IpAddress& ipAddress, const Port port);
 		IpSocketAddress(const IpSocketAddress& sockaddr);
 		IpSocketAddress(IpSocketAddress&& sockaddr) noexcept;
@@ -33,9 +44,18 @@ namespace Vnetworking::Sockets {
 		AddressFamily GetAddressFamily(void) const override;
 		IpAddress GetIpAddress(void) const;
 		Port GetPort(void) const;
+		std::uint32_t GetScopeId(void) const;
 
 		void SetIpAddress(const IpAddress& ipAddress);
 		void SetPort(const Port port);
+		void SetScopeId(const std::uint32_t scopeId);
+
+		const void* GetNativeSocketAddress(void) const override;
+		std::int32_t GetNativeSocketAddressLength(void) const override;
+		void SetNativeSocketAddress(const void* sockaddr, const std::int32_t length);
+
+	private:
+		void UpdateNativeSocketAddress(void);
 
 	};
 
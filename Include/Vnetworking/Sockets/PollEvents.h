@@ -14,12 +14,36 @@ namespace Vnetworking::Sockets {
 
 	enum class VNETCOREAPI PollEvents : std::uint32_t {
 
+		NONE = 0,
 		READ = 1,
 		WRITE = 2,
-		ERROR = 3,
+		ERROR = 4,
+		HANGUP = 8,
 
 	};
 
+	static inline PollEvents operator| (const PollEvents a, const PollEvents b) noexcept {
+		return static_cast<PollEvents>(static_cast<std::uint32_t>(a) | static_cast<std::uint32_t>(b));
+	}
+
+	static inline PollEvents& operator|= (PollEvents& a, const PollEvents b) noexcept {
+		a = (a | b);
+		return a;
+	}
+
+	static inline PollEvents operator& (const PollEvents a, const PollEvents b) noexcept {
+		return static_cast<PollEvents>(static_cast<std::uint32_t>(a) & static_cast<std::uint32_t>(b));
+	}
+
+	static inline PollEvents& operator&= (PollEvents& a, const PollEvents b) noexcept {
+		a = (a & b);
+		return a;
+	}
+
+	static inline PollEvents operator~ (const PollEvents a) noexcept {
+		return static_cast<PollEvents>(~static_cast<std::uint32_t>(a));
+	}
+
 }
 
 #endif // _NE_POLLEVENTS_H_
\ No newline at end of file
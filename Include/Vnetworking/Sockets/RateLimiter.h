@@ -0,0 +1,68 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_RATELIMITER_H_
+#define _NE_RATELIMITER_H_
+
+#include <Vnetworking/Exports.h>
+
+#include <cstdint>
+#include <chrono>
+#include <mutex>
+
+namespace Vnetworking::Sockets {
+
+	// RateLimiter is a token bucket that limits both bytes and packets per second.
+	// a send may start as soon as the bucket holds as many tokens as it needs, or a full burst
+	// for sends larger than the burst. the send then takes all of its tokens, which can leave the
+	// bucket in debt, so the long-term rate holds regardless of the send sizes. the tokens of data that
+	// wasn't sent (e.g. the rest of a partial send) are given back with Release.
+	// a rate of 0 means unlimited. one RateLimiter can be shared by a group of sockets
+	// (see Socket::SetRateLimiter), and is thread safe.
+	class VNETCOREAPI RateLimiter {
+
+	private:
+		std::uint64_t m_bytesPerSecond;
+		std::uint64_t m_packetsPerSecond;
+		std::uint64_t m_byteBurst;
+		std::uint64_t m_packetBurst;
+
+		double m_byteTokens;
+		double m_packetTokens;
+		std::chrono::steady_clock::time_point m_lastRefill;
+
+		mutable std::mutex m_mutex;
+
+	public:
+		RateLimiter(const std::uint64_t bytesPerSecond, const std::uint64_t packetsPerSecond, const std::uint64_t byteBurst, const std::uint64_t packetBurst);
+		RateLimiter(const std::uint64_t bytesPerSecond, const std::uint64_t packetsPerSecond);
+		RateLimiter(const RateLimiter&) = delete;
+		RateLimiter(RateLimiter&&) noexcept = delete;
+		virtual ~RateLimiter(void);
+
+		RateLimiter& operator= (const RateLimiter&) = delete;
+		RateLimiter& operator= (RateLimiter&&) noexcept = delete;
+
+		std::uint64_t GetBytesPerSecond(void) const;
+		std::uint64_t GetPacketsPerSecond(void) const;
+		std::uint64_t GetByteBurst(void) const;
+		std::uint64_t GetPacketBurst(void) const;
+
+		void SetRate(const std::uint64_t bytesPerSecond, const std::uint64_t packetsPerSecond, const std::uint64_t byteBurst, const std::uint64_t packetBurst);
+
+		bool TryAcquire(const std::uint64_t bytes, const std::uint64_t packets);
+		void Acquire(const std::uint64_t bytes, const std::uint64_t packets);
+		void Release(const std::uint64_t bytes, const std::uint64_t packets);
+		std::chrono::microseconds GetDelay(const std::uint64_t bytes, const std::uint64_t packets) const;
+
+	private:
+		void Refill(void);
+		std::chrono::microseconds GetDelayLocked(const std::uint64_t bytes, const std::uint64_t packets) const;
+
+	};
+
+}
+
+#endif // _NE_RATELIMITER_H_
\ No newline at end of file
@@ -0,0 +1,63 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_SHARDEDLISTENER_H_
+#define _NE_SHARDEDLISTENER_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/Platform.h>
+#include <Vnetworking/Sockets/Socket.h>
+#include <Vnetworking/Sockets/IpSocketAddress.h>
+
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <functional>
+
+namespace Vnetworking::Sockets {
+
+	// ShardedListener accepts connections on one port with a group of worker threads.
+	// on Linux, every worker owns its own SO_REUSEPORT listening socket, so the kernel spreads incoming
+	// connections across the workers and they never contend for a shared accept queue.
+	// with CPU steering enabled, a connection is passed to the listener of the CPU that received it.
+	// on Windows, the workers share a single listening socket.
+	class VNETCOREAPI ShardedListener {
+
+	public:
+		// called on the worker thread of the shard that accepted the connection.
+		using ConnectionHandler = std::function<void(const std::int32_t shard, Socket socket)>;
+
+	private:
+		std::int32_t m_shardCount;
+		std::vector<Socket> m_listeners;
+		std::vector<std::thread> m_workers;
+		std::atomic<bool> m_running;
+
+	public:
+		ShardedListener(const IpSocketAddress& sockaddr, const std::int32_t shardCount, const bool steerByCpu);
+		ShardedListener(const IpSocketAddress& sockaddr, const std::int32_t shardCount);
+		ShardedListener(const IpSocketAddress& sockaddr);
+		ShardedListener(const ShardedListener&) = delete;
+		ShardedListener(ShardedListener&&) noexcept = delete;
+		virtual ~ShardedListener(void);
+
+		ShardedListener& operator= (const ShardedListener&) = delete;
+		ShardedListener& operator= (ShardedListener&&) noexcept = delete;
+
+		std::int32_t GetShardCount(void) const;
+		const Socket& GetListener(const std::int32_t shard) const;
+
+		void Start(const ConnectionHandler& handler);
+		void Stop(void);
+
+	private:
+		void WorkerThreadProc(const std::int32_t shard, const ConnectionHandler handler);
+
+	};
+
+}
+
+#endif // _NE_SHARDEDLISTENER_H_
\ No newline at end of file
@@ -7,16 +7,29 @@
 #define _NE_SOCKET_H_
 
 #include <Vnetworking/Exports.h>
+#include <Vnetworking/Task.h>
+#include <Vnetworking/IpAddress.h>
 #include <Vnetworking/Sockets/AddressFamily.h>
 #include <Vnetworking/Sockets/SocketType.h>
 #include <Vnetworking/Sockets/ProtocolType.h>
 #include <Vnetworking/Sockets/ShutdownSocket.h>
 #include <Vnetworking/Sockets/ISocketAddress.h>
 #include <Vnetworking/Sockets/SocketFlags.h>
+#include <Vnetworking/Sockets/SocketOption.h>
+#include <Vnetworking/Sockets/SocketResult.h>
 #include <Vnetworking/Sockets/PollEvents.h>
+#include <Vnetworking/Sockets/Datagram.h>
+#include <Vnetworking/Sockets/ZeroCopyCompletion.h>
+#include <Vnetworking/Sockets/TransportInfo.h>
+#include <Vnetworking/Sockets/SocketTimestamp.h>
+#include <Vnetworking/Sockets/TransmitTimestamp.h>
+#include <Vnetworking/Sockets/RateLimiter.h>
 
 #include <cstdint>
 #include <span>
+#include <filesystem>
+#include <optional>
+#include <memory>
 
 namespace Vnetworking::Sockets {
 
@@ -24,14 +37,23 @@ namespace Vnetworking::Sockets {
 
 	constexpr NativeSocket_t INVALID_SOCKET_HANDLE = (NativeSocket_t)(~0);
 
+	// a file descriptor on Linux, a file HANDLE on Windows.
+	typedef std::intptr_t NativeFile_t;
+
+	struct AcceptedConnection;
+	class IoContext;
+
 	class VNETCOREAPI Socket { 
 	
+	friend class IoRing;
+
 	private:
 		AddressFamily m_af;
 		SocketType m_type;
 		ProtocolType m_proto;
 
 		NativeSocket_t m_socket;
+		std::shared_ptr<RateLimiter> m_rateLimiter;
 
 	private:
 		Socket(const NativeSocket_t, const AddressFamily, const SocketType, const ProtocolType);
@@ -57,10 +79,13 @@ namespace Vnetworking::Sockets {
 	
 		void Bind(const ISocketAddress& sockaddr) const;
 		void Connect(const ISocketAddress& sockaddr) const;
+		std::int32_t ConnectWithData(const ISocketAddress& sockaddr, const std::span<const std::uint8_t>& data, const std::int32_t size) const;
 
 		void Listen(void) const;
 		void Listen(const std::int32_t backlog) const;
 		Socket Accept(void) const;
+		SocketResult TryAccept(std::optional<Socket>& socket) const;
+		std::int32_t AcceptMany(const std::span<AcceptedConnection>& connections) const;
 
 		std::int32_t Send(const std::span<const std::uint8_t>& data, const std::int32_t offset, const std::int32_t size, const SocketFlags flags) const;
 		std::int32_t Send(const std::span<const std::uint8_t>& data, const std::int32_t size, const SocketFlags flags) const;
@@ -69,6 +94,36 @@ namespace Vnetworking::Sockets {
 		std::int32_t Receive(const std::span<std::uint8_t>& data, const std::int32_t offset, const std::int32_t size, const SocketFlags flags) const;
 		std::int32_t Receive(const std::span<std::uint8_t>& data, const std::int32_t size, const SocketFlags flags) const;
 		std::int32_t Receive(const std::span<std::uint8_t>& data, const std::int32_t size) const;
+		std::int32_t Receive(const std::span<std::uint8_t>& data, const std::int32_t size, const SocketFlags flags, SocketTimestamp& timestamp) const;
+
+		SocketResult TrySend(const std::span<const std::uint8_t>& data, const std::int32_t size, const SocketFlags flags) const noexcept;
+		SocketResult TrySend(const std::span<const std::uint8_t>& data, const std::int32_t size) const noexcept;
+
+		SocketResult TryReceive(const std::span<std::uint8_t>& data, const std::int32_t size, const SocketFlags flags) const noexcept;
+		SocketResult TryReceive(const std::span<std::uint8_t>& data, const std::int32_t size) const noexcept;
+
+		std::int32_t SendV(const std::span<const std::span<const std::uint8_t>>& buffers, const SocketFlags flags) const;
+		std::int32_t SendV(const std::span<const std::span<const std::uint8_t>>& buffers) const;
+		SocketResult TrySendV(const std::span<const std::span<const std::uint8_t>>& buffers, const SocketFlags flags) const noexcept;
+		SocketResult TrySendV(const std::span<const std::span<const std::uint8_t>>& buffers) const noexcept;
+
+		std::int32_t ReceiveV(const std::span<const std::span<std::uint8_t>>& buffers, const SocketFlags flags) const;
+		std::int32_t ReceiveV(const std::span<const std::span<std::uint8_t>>& buffers) const;
+
+		std::int32_t SendZeroCopy(const std::span<const std::uint8_t>& data, const std::int32_t size, const SocketFlags flags) const;
+		std::int32_t SendZeroCopy(const std::span<const std::uint8_t>& data, const std::int32_t size) const;
+		std::int32_t GetZeroCopyCompletions(const std::span<ZeroCopyCompletion>& completions) const;
+
+		Task<Socket> AcceptAsync(IoContext& context) const;
+		Task<void> ConnectAsync(IoContext& context, const ISocketAddress& sockaddr) const;
+		Task<std::int32_t> SendAsync(IoContext& context, const std::span<const std::uint8_t> data, const std::int32_t size, const SocketFlags flags) const;
+		Task<std::int32_t> SendAsync(IoContext& context, const std::span<const std::uint8_t> data, const std::int32_t size) const;
+		Task<std::int32_t> ReceiveAsync(IoContext& context, const std::span<std::uint8_t> data, const std::int32_t size, const SocketFlags flags) const;
+		Task<std::int32_t> ReceiveAsync(IoContext& context, const std::span<std::uint8_t> data, const std::int32_t size) const;
+
+		std::int64_t SendFile(const std::filesystem::path& path, const std::int64_t offset, const std::int64_t length) const;
+		std::int64_t SendFile(const std::filesystem::path& path) const;
+		std::int64_t SendFile(const NativeFile_t file, const std::int64_t offset, const std::int64_t length) const;
 
 		std::int32_t SendTo(const std::span<const std::uint8_t>& data, const std::int32_t offset, const std::int32_t size, const SocketFlags flags, const ISocketAddress& sockaddr) const;
 		std::int32_t SendTo(const std::span<const std::uint8_t>& data, const std::int32_t size, const SocketFlags flags, const ISocketAddress& sockaddr) const;
@@ -77,6 +132,27 @@ namespace Vnetworking::Sockets {
 		std::int32_t ReceiveFrom(const std::span<std::uint8_t>& data, const std::int32_t offset, const std::int32_t size, const SocketFlags flags, ISocketAddress& sockaddr) const;
 		std::int32_t ReceiveFrom(const std::span<std::uint8_t>& data, const std::int32_t size, const SocketFlags flags, ISocketAddress& sockaddr) const;
 		std::int32_t ReceiveFrom(const std::span<std::uint8_t>& data, const std::int32_t size, ISocketAddress& sockaddr) const;
+		std::int32_t ReceiveFrom(const std::span<std::uint8_t>& data, const std::int32_t size, const SocketFlags flags, ISocketAddress& sockaddr, SocketTimestamp& timestamp) const;
+
+		std::int32_t GetTransmitTimestamps(const std::span<TransmitTimestamp>& timestamps) const;
+
+		std::int32_t SendToBatch(const std::span<const OutgoingDatagram>& datagrams, const SocketFlags flags) const;
+		std::int32_t SendToBatch(const std::span<const OutgoingDatagram>& datagrams) const;
+
+		std::int32_t ReceiveFromBatch(const std::span<IncomingDatagram>& datagrams, const SocketFlags flags) const;
+		std::int32_t ReceiveFromBatch(const std::span<IncomingDatagram>& datagrams) const;
+
+		std::int32_t SendToSegmented(const std::span<const std::uint8_t>& data, const std::int32_t size, const std::int32_t segmentSize, const SocketFlags flags, const ISocketAddress& sockaddr) const;
+		std::int32_t SendToSegmented(const std::span<const std::uint8_t>& data, const std::int32_t size, const std::int32_t segmentSize, const ISocketAddress& sockaddr) const;
+
+		std::int32_t ReceiveFromCoalesced(const std::span<std::uint8_t>& data, const std::int32_t size, const SocketFlags flags, ISocketAddress& sockaddr, std::int32_t& segmentSize) const;
+		std::int32_t ReceiveFromCoalesced(const std::span<std::uint8_t>& data, const std::int32_t size, ISocketAddress& sockaddr, std::int32_t& segmentSize) const;
+
+		std::int32_t SendDescriptors(const std::span<const std::uint8_t>& data, const std::int32_t size, const std::span<const NativeSocket_t>& descriptors) const;
+		std::int32_t ReceiveDescriptors(const std::span<std::uint8_t>& data, const std::int32_t size, const std::span<NativeSocket_t>& descriptors, std::int32_t& count, bool& truncated) const;
+		std::int32_t ReceiveDescriptors(const std::span<std::uint8_t>& data, const std::int32_t size, const std::span<NativeSocket_t>& descriptors, std::int32_t& count) const;
+		void SendSocket(const Socket& socket) const;
+		Socket ReceiveSocket(void) const;
 
 		std::int32_t GetAvailableBytes(void) const;
 
@@ -85,6 +161,33 @@ namespace Vnetworking::Sockets {
 
 		bool Poll(const PollEvents pollEvent, const std::int32_t timeout) const;
 
+		TransportInfo GetTransportInfo(void) const;
+		std::int32_t GetIncomingCpu(void) const;
+		std::uint32_t GetNapiId(void) const;
+
+		void SetSocketOption(const SocketOption option, const std::int32_t value) const;
+		std::int32_t GetSocketOption(const SocketOption option) const;
+
+		void SetBlocking(const bool blocking) const;
+		void SetReceiveCoalescing(const bool enabled) const;
+		void SetZeroCopy(const bool enabled) const;
+		void SetTimestamping(const bool enabled) const;
+		void SetMaxPacingRate(const std::uint64_t rate) const;
+
+		void JoinMulticastGroup(const IpAddress& group, const std::uint32_t interfaceIndex) const;
+		void JoinMulticastGroup(const IpAddress& group) const;
+		void JoinMulticastGroup(const IpAddress& group, const IpAddress& source, const std::uint32_t interfaceIndex) const;
+		void LeaveMulticastGroup(const IpAddress& group, const std::uint32_t interfaceIndex) const;
+		void LeaveMulticastGroup(const IpAddress& group) const;
+		void LeaveMulticastGroup(const IpAddress& group, const IpAddress& source, const std::uint32_t interfaceIndex) const;
+
+		void SetMulticastInterface(const std::uint32_t interfaceIndex) const;
+		void SetMulticastTimeToLive(const std::int32_t ttl) const;
+		void SetMulticastLoopback(const bool enabled) const;
+
+		void SetRateLimiter(const std::shared_ptr<RateLimiter>& rateLimiter);
+		std::shared_ptr<RateLimiter> GetRateLimiter(void) const;
+
 	};
 
 }
@@ -0,0 +1,36 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_SOCKETOPTION_H_
+#define _NE_SOCKETOPTION_H_
+
+#include <Vnetworking/Exports.h>
+
+#include <cstdint>
+
+namespace Vnetworking::Sockets {
+
+	// options for Socket::SetSocketOption and Socket::GetSocketOption.
+	// boolean options take 0 or 1. options marked as Linux only are not supported on Windows.
+	enum class VNETCOREAPI SocketOption : std::int32_t {
+
+		NO_DELAY, // disables Nagle's algorithm (TCP_NODELAY).
+		REUSE_ADDRESS, // SO_REUSEADDR
+		REUSE_PORT, // lets multiple sockets bind to the same address and port (SO_REUSEPORT, Linux only).
+		SEND_BUFFER_SIZE, // SO_SNDBUF, in bytes.
+		RECEIVE_BUFFER_SIZE, // SO_RCVBUF, in bytes.
+		KEEP_ALIVE, // SO_KEEPALIVE
+		CORK, // holds back partial TCP segments until uncorked (TCP_CORK, Linux only).
+		QUICK_ACK, // sends ACKs immediately; the kernel may reset it (TCP_QUICKACK, Linux only).
+		BUSY_POLL, // busy-polls the device queue on receive, in microseconds (SO_BUSY_POLL, Linux only).
+		FAST_OPEN, // on a listener, accepts data in SYNs; the length of the pending Fast Open queue (TCP_FASTOPEN, a boolean on Windows).
+		FAST_OPEN_CONNECT, // makes Connect use Fast Open, sending the first data in the SYN (TCP_FASTOPEN_CONNECT, Linux only).
+		MAX_PACING_RATE, // the rate the kernel paces the socket's packets at, in bytes per second (SO_MAX_PACING_RATE, Linux only). see also Socket::SetMaxPacingRate.
+
+	};
+
+}
+
+#endif // _NE_SOCKETOPTION_H_
\ No newline at end of file
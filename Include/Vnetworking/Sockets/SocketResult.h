@@ -0,0 +1,25 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_SOCKETRESULT_H_
+#define _NE_SOCKETRESULT_H_
+
+#include <Vnetworking/Exports.h>
+
+#include <cstdint>
+
+namespace Vnetworking::Sockets {
+
+	// the outcome of a non-throwing socket operation (Socket::TrySend, Socket::TryReceive, Socket::TryAccept).
+	typedef struct {
+		std::int32_t Bytes; // the number of bytes transferred (0 if the operation failed).
+		std::int32_t ErrorCode; // 0 if the operation succeeded, otherwise the error code it failed with.
+		bool WouldBlock; // true if the operation failed only because the socket is non-blocking and isn't ready, or was rate limited.
+		std::int32_t RetryDelay; // if the socket's rate limiter held the operation back, how long (in milliseconds) to wait before retrying it, otherwise 0.
+	} SocketResult;
+
+}
+
+#endif // _NE_SOCKETRESULT_H_
\ No newline at end of file
@@ -0,0 +1,25 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_SOCKETTIMESTAMP_H_
+#define _NE_SOCKETTIMESTAMP_H_
+
+#include <Vnetworking/Exports.h>
+
+#include <cstdint>
+
+namespace Vnetworking::Sockets {
+
+	// the time at which the kernel (or the network card) handled a packet, in nanoseconds since the Unix epoch.
+	// a timestamp is 0 if it wasn't generated: hardware timestamps require a network card with
+	// timestamping enabled, and no timestamps are reported on Windows.
+	typedef struct {
+		std::int64_t Software;
+		std::int64_t Hardware;
+	} SocketTimestamp;
+
+}
+
+#endif // _NE_SOCKETTIMESTAMP_H_
\ No newline at end of file
@@ -0,0 +1,26 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_TRANSMITTIMESTAMP_H_
+#define _NE_TRANSMITTIMESTAMP_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/Sockets/SocketTimestamp.h>
+
+#include <cstdint>
+
+namespace Vnetworking::Sockets {
+
+	// reports when data passed to a send function has left the host.
+	// for datagram sockets, Id is the number of the send call (counted per socket, starting from 0).
+	// for stream sockets, Id is the offset of the last byte of the send call in the stream.
+	typedef struct {
+		std::uint32_t Id;
+		SocketTimestamp Timestamp;
+	} TransmitTimestamp;
+
+}
+
+#endif // _NE_TRANSMITTIMESTAMP_H_
\ No newline at end of file
@@ -0,0 +1,35 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_TRANSPORTINFO_H_
+#define _NE_TRANSPORTINFO_H_
+
+#include <Vnetworking/Exports.h>
+
+#include <cstdint>
+
+namespace Vnetworking::Sockets {
+
+	// a snapshot of a TCP connection's transport state, as returned by Socket::GetTransportInfo.
+	// times are in microseconds, sizes in bytes and rates in bytes per second.
+	// fields that the platform (or kernel version) doesn't report are 0.
+	typedef struct {
+		std::uint32_t Rtt; // smoothed round-trip time.
+		std::uint32_t RttVariance;
+		std::uint32_t MinRtt;
+		std::uint32_t MaxSegmentSize;
+		std::uint64_t CongestionWindow;
+		std::uint64_t BytesInFlight; // sent, but not yet acknowledged.
+		std::uint32_t Retransmits; // the total number of retransmitted segments.
+		std::uint64_t BytesRetransmitted;
+		std::uint64_t BytesSent;
+		std::uint64_t BytesReceived;
+		std::uint64_t PacingRate;
+		std::uint64_t DeliveryRate;
+	} TransportInfo;
+
+}
+
+#endif // _NE_TRANSPORTINFO_H_
\ No newline at end of file
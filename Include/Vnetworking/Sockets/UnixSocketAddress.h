@@ -0,0 +1,66 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_UNIXSOCKETADDRESS_H_
+#define _NE_UNIXSOCKETADDRESS_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/Sockets/ISocketAddress.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <array>
+
+namespace Vnetworking::Sockets {
+
+	// large enough to hold sockaddr_un.
+	constexpr std::size_t UNIX_NATIVE_SOCKADDR_SIZE = 112;
+
+	// UnixSocketAddress is the address of a Unix domain (AddressFamily::UNIX) socket.
+	// a path address is a file in the file system: binding a socket creates the file, and it
+	// has to be removed once the socket is no longer used. an abstract address (Linux only)
+	// is just a name, which goes away when the last socket bound to it is closed.
+	// an address with an empty path is unnamed, which is what unbound and socketpair sockets report.
+	class VNETCOREAPI UnixSocketAddress : public ISocketAddress {
+
+	private:
+		std::string m_path;
+		bool m_abstract;
+
+		alignas(std::uint64_t) std::array<std::uint8_t, UNIX_NATIVE_SOCKADDR_SIZE> m_sockaddr;
+		std::int32_t m_sockaddrLen;
+
+	public:
+		UnixSocketAddress(void);
+		UnixSocketAddress(const std::string_view path);
+		UnixSocketAddress(const std::string_view path, const bool abstract);
+		UnixSocketAddress(const UnixSocketAddress& sockaddr);
+		UnixSocketAddress(UnixSocketAddress&& sockaddr) noexcept;
+		virtual ~UnixSocketAddress(void);
+
+		UnixSocketAddress& operator= (const UnixSocketAddress& sockaddr);
+		UnixSocketAddress& operator= (UnixSocketAddress&& sockaddr) noexcept;
+		bool operator== (const UnixSocketAddress& sockaddr) const;
+
+		AddressFamily GetAddressFamily(void) const override;
+		const std::string& GetPath(void) const;
+		bool IsAbstract(void) const;
+		bool IsUnnamed(void) const;
+
+		void SetPath(const std::string_view path, const bool abstract);
+
+		const void* GetNativeSocketAddress(void) const override;
+		std::int32_t GetNativeSocketAddressLength(void) const override;
+		void SetNativeSocketAddress(const void* sockaddr, const std::int32_t length);
+
+	private:
+		void UpdateNativeSocketAddress(void);
+
+	};
+
+}
+
+#endif // _NE_UNIXSOCKETADDRESS_H_
\ No newline at end of file
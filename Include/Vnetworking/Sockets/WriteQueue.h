@@ -0,0 +1,76 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_WRITEQUEUE_H_
+#define _NE_WRITEQUEUE_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/Platform.h>
+#include <Vnetworking/Sockets/Socket.h>
+#include <Vnetworking/Sockets/SocketResult.h>
+
+#include <cstdint>
+#include <span>
+#include <deque>
+#include <vector>
+#include <functional>
+
+namespace Vnetworking::Sockets {
+
+	// WriteQueue buffers outgoing data for one connection. small writes are coalesced into larger chunks,
+	// and Flush sends the queued chunks with vectored sends once the socket is writable
+	// (or, if the socket has a rate limiter, once the limiter lets the data through).
+	// when the queued data reaches the high watermark, the backpressure handler is called with true,
+	// and the producer should stop writing. once Flush has drained the queue down to the low watermark,
+	// the handler is called with false. Write itself never blocks and never drops data.
+	// a WriteQueue is meant to be used from the connection's event loop thread, and is not thread safe.
+	class VNETCOREAPI WriteQueue {
+
+	public:
+		using BackpressureHandler = std::function<void(const bool paused)>;
+
+	private:
+		const Socket* m_socket;
+		std::size_t m_lowWatermark;
+		std::size_t m_highWatermark;
+		BackpressureHandler m_handler;
+
+		std::deque<std::vector<std::uint8_t>> m_chunks;
+		std::size_t m_offset; // bytes of the first chunk that were already sent.
+		std::size_t m_queued;
+		bool m_paused;
+
+	public:
+		WriteQueue(const Socket& socket, const std::size_t lowWatermark, const std::size_t highWatermark, const BackpressureHandler& handler);
+		WriteQueue(const Socket& socket, const std::size_t lowWatermark, const std::size_t highWatermark);
+		WriteQueue(const WriteQueue&) = delete;
+		WriteQueue(WriteQueue&&) noexcept = delete;
+		virtual ~WriteQueue(void);
+
+		WriteQueue& operator= (const WriteQueue&) = delete;
+		WriteQueue& operator= (WriteQueue&&) noexcept = delete;
+
+		const Socket& GetSocket(void) const;
+		std::size_t GetQueuedSize(void) const;
+		std::size_t GetLowWatermark(void) const;
+		std::size_t GetHighWatermark(void) const;
+		bool IsEmpty(void) const;
+		bool IsPaused(void) const;
+
+		void Write(const std::span<const std::uint8_t>& data);
+		void Write(std::vector<std::uint8_t>&& data);
+
+		SocketResult Flush(void);
+		void Clear(void);
+
+	private:
+		void OnQueued(const std::size_t size);
+		void OnSent(std::size_t size);
+
+	};
+
+}
+
+#endif // _NE_WRITEQUEUE_H_
\ No newline at end of file
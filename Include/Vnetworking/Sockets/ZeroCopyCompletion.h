@@ -0,0 +1,25 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_ZEROCOPYCOMPLETION_H_
+#define _NE_ZEROCOPYCOMPLETION_H_
+
+#include <Vnetworking/Exports.h>
+
+#include <cstdint>
+
+namespace Vnetworking::Sockets {
+
+	// reports that the buffers of a range of Socket::SendZeroCopy calls are no longer used by the kernel.
+	// SendZeroCopy calls are numbered per socket by the kernel, starting from 0.
+	typedef struct {
+		std::uint32_t First; // the number of the first completed call.
+		std::uint32_t Last; // the number of the last completed call (inclusive).
+		bool Copied; // true if the kernel fell back to copying the data.
+	} ZeroCopyCompletion;
+
+}
+
+#endif // _NE_ZEROCOPYCOMPLETION_H_
\ No newline at end of file
@@ -0,0 +1,139 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_TASK_H_
+#define _NE_TASK_H_
+
+#include <coroutine>
+#include <optional>
+#include <utility>
+#include <exception>
+#include <stdexcept>
+
+namespace Vnetworking {
+
+	template <typename T>
+	class Task;
+
+	namespace Private {
+
+		// resumes the coroutine that awaited the task, once the task finishes.
+		struct TaskFinalAwaiter {
+
+			bool await_ready(void) const noexcept { return false; }
+			void await_resume(void) const noexcept { }
+
+			template <typename Promise>
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> coroutine) const noexcept {
+				if (coroutine.promise().m_continuation) return coroutine.promise().m_continuation;
+				return std::noop_coroutine();
+			}
+
+		};
+
+		struct TaskPromiseBase {
+
+			std::coroutine_handle<> m_continuation;
+			std::exception_ptr m_exception;
+
+			std::suspend_always initial_suspend(void) const noexcept { return { }; }
+			TaskFinalAwaiter final_suspend(void) const noexcept { return { }; }
+			void unhandled_exception(void) noexcept { this->m_exception = std::current_exception(); }
+
+		};
+
+		template <typename T>
+		struct TaskPromise : public TaskPromiseBase {
+
+			std::optional<T> m_value;
+
+			Task<T> get_return_object(void) noexcept;
+			
+			template <typename U>
+			void return_value(U&& value) { this->m_value.emplace(std::forward<U>(value)); }
+
+			T GetResult(void) {
+				if (this->m_exception) std::rethrow_exception(this->m_exception);
+				return std::move(*this->m_value);
+			}
+
+		};
+
+		template <>
+		struct TaskPromise<void> : public TaskPromiseBase {
+
+			Task<void> get_return_object(void) noexcept;
+			void return_void(void) const noexcept { }
+
+			void GetResult(void) {
+				if (this->m_exception) std::rethrow_exception(this->m_exception);
+			}
+
+		};
+
+	}
+
+	// Task is a lazily started coroutine that produces a value of type T.
+	// the task starts running when it's awaited, and resumes the awaiting coroutine when it finishes.
+	// exceptions thrown inside the task are rethrown from co_await.
+	template <typename T = void>
+	class Task {
+
+	public:
+		using promise_type = Private::TaskPromise<T>;
+
+	private:
+		std::coroutine_handle<promise_type> m_coroutine;
+
+	public:
+		Task(void) noexcept : m_coroutine(nullptr) { }
+		explicit Task(const std::coroutine_handle<promise_type> coroutine) noexcept : m_coroutine(coroutine) { }
+		Task(const Task&) = delete;
+		Task(Task&& task) noexcept : m_coroutine(std::exchange(task.m_coroutine, nullptr)) { }
+		virtual ~Task(void) { if (this->m_coroutine) this->m_coroutine.destroy(); }
+
+		Task& operator= (const Task&) = delete;
+		Task& operator= (Task&& task) noexcept {
+			if (this->m_coroutine) this->m_coroutine.destroy();
+			this->m_coroutine = std::exchange(task.m_coroutine, nullptr);
+			return static_cast<Task&>(*this);
+		}
+
+		bool IsDone(void) const noexcept {
+			return (!this->m_coroutine || this->m_coroutine.done());
+		}
+
+		bool await_ready(void) const noexcept {
+			return this->IsDone();
+		}
+
+		std::coroutine_handle<> await_suspend(const std::coroutine_handle<> awaiter) noexcept {
+			this->m_coroutine.promise().m_continuation = awaiter;
+			return this->m_coroutine;
+		}
+
+		T await_resume(void) {
+			if (!this->m_coroutine) throw std::logic_error("The task is empty.");
+			return this->m_coroutine.promise().GetResult();
+		}
+
+	};
+
+	namespace Private {
+
+		template <typename T>
+		inline Task<T> TaskPromise<T>::get_return_object() noexcept {
+			return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+		}
+
+		inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+			return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+		}
+
+	}
+
+}
+
+#endif // _NE_TASK_H_
\ No newline at end of file
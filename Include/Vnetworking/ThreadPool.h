@@ -13,6 +13,7 @@
 #include <functional>
 #include <queue>
 #include <mutex>
+#include <condition_variable>
 #include <tuple>
 #include <exception>
 #include <stdexcept>
@@ -0,0 +1,92 @@
+/*
+	Vnetworking Library
+	Copyright (C) V0idPointer
+*/
+
+#ifndef _NE_TIMERWHEEL_H_
+#define _NE_TIMERWHEEL_H_
+
+#include <Vnetworking/Exports.h>
+#include <Vnetworking/ThreadPool.h>
+
+#include <cstdint>
+#include <array>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <mutex>
+
+namespace Vnetworking {
+
+	typedef std::uint64_t TimerId;
+
+	constexpr TimerId INVALID_TIMER_ID = 0;
+
+	// TimerWheel is a hierarchical timing wheel: scheduling and cancelling a timer are O(1).
+	// time is measured in ticks (1 ms by default), and timers are kept in 4 levels of 256 slots.
+	// timers due within 256 ticks live in the first level; later timers are kept in coarser levels and
+	// are moved down as their time approaches.
+	// timers fire when Advance is called, either directly, from EventLoop::Wait, or on a ThreadPool.
+	// a timer never fires early, and fires at most one tick (plus the Advance delay) late.
+	class VNETCOREAPI TimerWheel {
+
+	private:
+		typedef struct {
+			std::uint64_t Expires;
+			std::function<void(void)> Callback;
+			std::uint32_t Prev;
+			std::uint32_t Next;
+			std::uint32_t Generation;
+			std::uint16_t Slot;
+			bool Active;
+		} Timer;
+
+		static constexpr std::size_t LEVELS = 4;
+		static constexpr std::size_t SLOTS_PER_LEVEL = 256;
+
+		std::int32_t m_resolution;
+		std::chrono::steady_clock::time_point m_start;
+		std::uint64_t m_currentTick;
+
+		std::vector<Timer> m_timers;
+		std::uint32_t m_freeList;
+		std::size_t m_activeCount;
+
+		std::array<std::uint32_t, (LEVELS * SLOTS_PER_LEVEL)> m_slots;
+		std::array<std::array<std::uint64_t, (SLOTS_PER_LEVEL / 64)>, LEVELS> m_occupied;
+
+		mutable std::mutex m_mutex;
+
+	public:
+		TimerWheel(void);
+		TimerWheel(const std::int32_t resolution);
+		TimerWheel(const TimerWheel&) = delete;
+		TimerWheel(TimerWheel&&) noexcept = delete;
+		virtual ~TimerWheel(void);
+
+		TimerWheel& operator= (const TimerWheel&) = delete;
+		TimerWheel& operator= (TimerWheel&&) noexcept = delete;
+
+		std::int32_t GetResolution(void) const;
+		std::size_t GetTimerCount(void) const;
+		std::int32_t GetNextTimeout(void) const;
+
+		TimerId Schedule(const std::int32_t timeout, std::function<void(void)> callback);
+		bool Cancel(const TimerId timer);
+
+		std::int32_t Advance(void);
+		std::int32_t Advance(ThreadPool<>& threadPool);
+
+	private:
+		std::uint64_t GetElapsedTicks(void) const;
+		void Link(const std::uint32_t index);
+		void Unlink(const std::uint32_t index);
+		void Release(const std::uint32_t index);
+		void Cascade(const std::size_t level, const std::size_t slot);
+		void CollectExpired(std::vector<std::function<void(void)>>& callbacks);
+
+	};
+
+}
+
+#endif // _NE_TIMERWHEEL_H_
\ No newline at end of file